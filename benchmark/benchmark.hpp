@@ -0,0 +1,121 @@
+/***************************************************************************
+ *            benchmark.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file benchmark.hpp
+ *  \brief Minimal harness for microbenchmarks with machine-readable output.
+ *  \details Each benchmark prints one JSON object per line to the standard output, with the suite and benchmark names,
+ *  the parameters, the number of operations per sample and the nanoseconds per operation across samples.
+ *  Options: --filter <substring> runs only the benchmarks whose name contains the substring,
+ *  --samples <n> sets the number of samples, --sample-ms <n> sets the minimum duration of a sample in milliseconds.
+ */
+
+#ifndef PRONEST_BENCHMARK_HPP
+#define PRONEST_BENCHMARK_HPP
+
+#include <chrono>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include "helper/macros.hpp"
+#include "helper/container.hpp"
+#include "helper/string.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+using Helper::Pair;
+using Helper::String;
+
+//! \brief The destination of kept values
+inline void const* volatile benchmark_sink = nullptr;
+
+//! \brief Prevent the compiler from optimising away the computation of \a value
+template<class T> inline void keep(T const& value) {
+    benchmark_sink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+//! \brief A suite of benchmarks, run as soon as they are declared
+class BenchmarkSuite {
+  public:
+    BenchmarkSuite(String const& name, int argc, const char* argv[]) : _name(name), _samples(5), _sample_ms(20) {
+        for (int i=1; i<argc; ++i) {
+            HELPER_ASSERT_MSG(i+1 < argc,"Missing value for option " << argv[i]);
+            if (std::strcmp(argv[i],"--filter") == 0) _filter = argv[++i];
+            else if (std::strcmp(argv[i],"--samples") == 0) _samples = std::strtoul(argv[++i],nullptr,10);
+            else if (std::strcmp(argv[i],"--sample-ms") == 0) _sample_ms = std::strtoul(argv[++i],nullptr,10);
+            else HELPER_FAIL_MSG("Unrecognised option " << argv[i]);
+        }
+        HELPER_PRECONDITION(_samples > 0);
+    }
+
+    //! \brief Run the benchmark \a name with the given \a parameters, where \a operation performs one operation
+    //! \details The number of operations per sample is calibrated to last at least the sample duration.
+    template<class F> void run(String const& name, List<Pair<String,size_t>> const& parameters, F const& operation) {
+        if (not _filter.empty() and name.find(_filter) == String::npos) return;
+        using Clock = std::chrono::steady_clock;
+        auto const minimum_duration = std::chrono::milliseconds(_sample_ms);
+
+        size_t operations = 1;
+        while (true) {
+            auto start = Clock::now();
+            for (size_t i=0; i<operations; ++i) operation();
+            if (Clock::now() - start >= minimum_duration) break;
+            operations *= 2;
+        }
+
+        List<double> ns_per_operation;
+        for (size_t s=0; s<_samples; ++s) {
+            auto start = Clock::now();
+            for (size_t i=0; i<operations; ++i) operation();
+            auto elapsed = std::chrono::duration<double,std::nano>(Clock::now() - start).count();
+            ns_per_operation.push_back(elapsed/static_cast<double>(operations));
+        }
+        std::sort(ns_per_operation.begin(),ns_per_operation.end());
+
+        std::cout << "{\"suite\":\"" << _name << "\",\"benchmark\":\"" << name << "\",\"parameters\":{";
+        for (size_t i=0; i<parameters.size(); ++i)
+            std::cout << (i>0 ? "," : "") << "\"" << parameters[i].first << "\":" << parameters[i].second;
+        std::cout << "},\"operations\":" << operations << ",\"samples\":" << _samples
+                  << ",\"ns_per_op_median\":" << ns_per_operation[_samples/2]
+                  << ",\"ns_per_op_min\":" << ns_per_operation.front()
+                  << ",\"ns_per_op_max\":" << ns_per_operation.back() << "}" << std::endl;
+    }
+
+  private:
+    String _name;
+    String _filter;
+    size_t _samples;
+    size_t _sample_ms;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_BENCHMARK_HPP
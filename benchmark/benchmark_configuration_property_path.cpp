@@ -0,0 +1,52 @@
+/***************************************************************************
+ *            benchmark_configuration_property_path.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "benchmark.hpp"
+#include "configuration_property_path.hpp"
+
+using namespace ProNest;
+
+ConfigurationPropertyPath make_path(size_t depth, String const& last) {
+    ConfigurationPropertyPath result;
+    for (size_t i=0; i+1<depth; ++i) result.append("node" + std::to_string(i));
+    return result.append(last);
+}
+
+int main(int argc, const char* argv[]) {
+    BenchmarkSuite suite("configuration_property_path",argc,argv);
+    for (size_t depth : {1u, 4u, 16u}) {
+        auto a = make_path(depth,"a");
+        auto b = make_path(depth,"b");
+        auto repr = b.repr();
+        suite.run("equality",{{"depth",depth}},[&]{ keep(a == b); });
+        suite.run("less",{{"depth",depth}},[&]{ keep(a < b); });
+        suite.run("hash",{{"depth",depth}},[&]{ keep(std::hash<ConfigurationPropertyPath>()(a)); });
+        suite.run("subpath",{{"depth",depth}},[&]{ keep(a.subpath()); });
+        suite.run("parse",{{"depth",depth}},[&]{ keep(ConfigurationPropertyPath::parse(repr)); });
+    }
+}
@@ -0,0 +1,70 @@
+/***************************************************************************
+ *            benchmark_configuration_search_point.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "benchmark.hpp"
+#include "benchmark_configurations.hpp"
+#include "configuration_search_space.hpp"
+#include "configuration_search_point.hpp"
+#include "configuration_search_population.hpp"
+#include "configuration_search_sampling.hpp"
+
+using namespace ProNest;
+
+int main(int argc, const char* argv[]) {
+    BenchmarkSuite suite("configuration_search_point",argc,argv);
+    for (size_t dimension : {2u, 8u, 32u}) {
+        for (size_t cardinality : {4u, 16u}) {
+            List<Pair<String,size_t>> parameters = {{"dimension",dimension},{"cardinality",cardinality}};
+            auto space = Configuration<BenchmarkNode>(dimension,cardinality,0).search_space();
+            auto point = space.initial_point();
+            size_t size = std::min<size_t>(16,space.total_points());
+            suite.run("make_adjacent_shifted",parameters,[&]{ keep(point.make_adjacent_shifted()); });
+            suite.run("make_random_shifted",parameters,[&]{ keep(point.make_random_shifted(size)); });
+            suite.run("make_extended_set_by_shifting",parameters,[&]{ keep(make_extended_set_by_shifting({point},size)); });
+            auto concurrent_parameters = parameters;
+            concurrent_parameters.push_back({"concurrency",4});
+            suite.run("make_extended_set_by_shifting",concurrent_parameters,[&]{ keep(make_extended_set_by_shifting({point},size,RandomEngine::thread_engine(),4)); });
+            suite.run("distance",parameters,[&]{ keep(point.distance(point)); });
+
+            List<ConfigurationSearchPoint> points;
+            for (size_t i=0; i<64; ++i) points.push_back(space.initial_point());
+            ConfigurationSearchPopulation population(points);
+            auto population_parameters = parameters;
+            population_parameters.push_back({"population",points.size()});
+            suite.run("distance_matrix",population_parameters,[&]{ keep(population.distance_matrix()); });
+            suite.run("diversity",population_parameters,[&]{ keep(population.diversity()); });
+
+            auto sampling_parameters = parameters;
+            sampling_parameters.push_back({"amount",size});
+            suite.run("make_sampled_points_latin_hypercube",sampling_parameters,[&]{ keep(make_sampled_points(space,size,ConfigurationSearchSampling::LATIN_HYPERCUBE)); });
+            suite.run("make_sampled_points_halton",sampling_parameters,[&]{ keep(make_sampled_points(space,size,ConfigurationSearchSampling::HALTON)); });
+            if (dimension <= SOBOL_MAXIMUM_DIMENSION)
+                suite.run("make_sampled_points_sobol",sampling_parameters,[&]{ keep(make_sampled_points(space,size,ConfigurationSearchSampling::SOBOL)); });
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *            benchmark_configurations.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file benchmark_configurations.hpp
+ *  \brief Configurations of parametrised width, cardinality and nesting depth, for benchmarking.
+ */
+
+#ifndef PRONEST_BENCHMARK_CONFIGURATIONS_HPP
+#define PRONEST_BENCHMARK_CONFIGURATIONS_HPP
+
+#include <iomanip>
+#include "helper/writable.hpp"
+#include "searchable_configuration.hpp"
+#include "configuration_property.tpl.hpp"
+#include "configurable.tpl.hpp"
+
+using namespace ProNest;
+using Helper::WritableInterface;
+
+using IntegerConfigurationProperty = RangeConfigurationProperty<int>;
+
+class BenchmarkNodeInterface : public WritableInterface {
+  public:
+    virtual BenchmarkNodeInterface* clone() const = 0;
+    virtual ~BenchmarkNodeInterface() = default;
+};
+
+using BenchmarkNodeConfigurationProperty = InterfaceListConfigurationProperty<BenchmarkNodeInterface>;
+
+class BenchmarkNode;
+
+namespace ProNest {
+
+template<> struct Configuration<BenchmarkNode> : public SearchableConfiguration {
+  public:
+    //! \brief Construct with \a width integer properties of \a cardinality values each, and a chain of \a depth
+    //! nested configurable objects with the same properties below
+    Configuration(size_t width, size_t cardinality, size_t depth);
+
+    //! \brief The name of the property with the given \a index
+    static String property_name(size_t index) {
+        std::ostringstream ss; ss << "p" << std::setw(3) << std::setfill('0') << index; return ss.str();
+    }
+};
+
+} // namespace ProNest
+
+class BenchmarkNode : public BenchmarkNodeInterface, public Configurable<BenchmarkNode> {
+  public:
+    BenchmarkNode(Configuration<BenchmarkNode> const& configuration) : Configurable<BenchmarkNode>(configuration) { }
+    ostream& _write(ostream& os) const override { os << "BenchmarkNode(" << configuration() << ")"; return os; }
+    BenchmarkNodeInterface* clone() const override { return new BenchmarkNode(configuration()); }
+};
+
+inline Configuration<BenchmarkNode>::Configuration(size_t width, size_t cardinality, size_t depth) {
+    HELPER_PRECONDITION(cardinality > 0);
+    for (size_t i=0; i<width; ++i)
+        add_property(property_name(i),IntegerConfigurationProperty(0,static_cast<int>(cardinality)-1));
+    if (depth > 0)
+        add_property("child",BenchmarkNodeConfigurationProperty(BenchmarkNode(Configuration(width,cardinality,depth-1))));
+}
+
+#endif // PRONEST_BENCHMARK_CONFIGURATIONS_HPP
@@ -0,0 +1,59 @@
+/***************************************************************************
+ *            benchmark_searchable_configuration.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "benchmark.hpp"
+#include "benchmark_configurations.hpp"
+#include "configuration_search_space.hpp"
+#include "configuration_search_point.hpp"
+
+using namespace ProNest;
+
+int main(int argc, const char* argv[]) {
+    BenchmarkSuite suite("searchable_configuration",argc,argv);
+    size_t const cardinality = 4;
+    List<Pair<size_t,size_t>> shapes = {{8,0},{64,0},{256,0},{4,4},{4,16}};
+    for (auto const& shape : shapes) {
+        size_t width = shape.first, depth = shape.second;
+        List<Pair<String,size_t>> parameters = {{"width",width},{"depth",depth},{"cardinality",cardinality}};
+        Configuration<BenchmarkNode> cfg(width,cardinality,depth);
+        auto first = Configuration<BenchmarkNode>::property_name(0);
+        auto change = [&]{ cfg.at<IntegerConfigurationProperty>(first).set(0,static_cast<int>(cardinality)-1); };
+
+        suite.run("search_space",parameters,[&]{ keep(cfg.search_space()); });
+        suite.run("search_space_after_change",parameters,[&]{ change(); keep(cfg.search_space()); });
+        suite.run("is_singleton",parameters,[&]{ keep(cfg.is_singleton()); });
+        suite.run("is_singleton_after_change",parameters,[&]{ change(); keep(cfg.is_singleton()); });
+
+        auto point = cfg.search_space().initial_point();
+        suite.run("make_singleton",parameters,[&]{ keep(make_singleton(cfg,point)); });
+
+        Configuration<BenchmarkNode> singleton_cfg(width,1,depth);
+        List<Pair<String,size_t>> singleton_parameters = {{"width",width},{"depth",depth},{"cardinality",1}};
+        suite.run("is_singleton",singleton_parameters,[&]{ keep(singleton_cfg.is_singleton()); });
+    }
+}
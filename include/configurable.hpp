@@ -51,6 +51,9 @@ class SearchableConfiguration;
 class ConfigurableInterface {
   public:
     virtual SearchableConfiguration const& searchable_configuration() const = 0;
+    //! \brief The configuration for modification of its properties, detached if shared with other objects
+    //! \details Used to set the properties of a configurable object held by a property
+    virtual SearchableConfiguration& mutable_searchable_configuration() = 0;
 };
 
 //! \brief Base template class to be specialised while deriving from SearchableConfigurationInterface
@@ -68,6 +71,7 @@ template<class C> class Configurable : public ConfigurableInterface {
     Configurable(Configuration<C> const& config);
     Configuration<C> const& configuration() const;
     SearchableConfiguration const& searchable_configuration() const override;
+    SearchableConfiguration& mutable_searchable_configuration() override;
   private:
     shared_ptr<Configuration<C>> _configuration;
 };
@@ -44,6 +44,11 @@ template<class C> SearchableConfiguration const& Configurable<C>::searchable_con
     return dynamic_cast<SearchableConfiguration const &>(*_configuration);
 }
 
+template<class C> SearchableConfiguration& Configurable<C>::mutable_searchable_configuration() {
+    if (_configuration.use_count() > 1) _configuration.reset(new Configuration<C>(*_configuration));
+    return dynamic_cast<SearchableConfiguration&>(*_configuration);
+}
+
 } // namespace ProNest
 
 #endif // PRONEST_CONFIGURABLE_TPL_HPP
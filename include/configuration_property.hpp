@@ -52,7 +52,10 @@ using std::shared_ptr;
 template<class T> class ConfigurationPropertyBase : public ConfigurationPropertyInterface {
   protected:
     ConfigurationPropertyBase(bool const& is_specified);
+    //! \brief Mark as specified, also updating the version
     void set_specified();
+    //! \brief Update the version after a modification
+    void update_version();
     virtual List<shared_ptr<T>> values() const = 0;
     virtual void local_set_single(int integer_value) = 0;
     virtual List<int> local_integer_values() const = 0;
@@ -62,11 +65,16 @@ template<class T> class ConfigurationPropertyBase : public ConfigurationProperty
 
     bool is_specified() const override;
     Map<ConfigurationPropertyPath,List<int>> integer_values() const override;
+    size_t version() const override;
+    //! \brief No nested configuration by default, overridden for properties that can hold configurable objects
+    SearchableConfiguration* nested_configuration() override;
+    SearchableConfiguration const* nested_configuration() const override;
 
     //! \brief Supplies the values from the property, empty if not specified, the lower/upper bounds if a range
     ostream& _write(ostream& os) const override;
   private:
     bool _is_specified;
+    size_t _version;
 };
 
 //! \brief A property for a boolean value.
@@ -83,6 +91,7 @@ class BooleanConfigurationProperty final : public ConfigurationPropertyBase<bool
     ConfigurationPropertyInterface* clone() const override;
 
     ConfigurationPropertyInterface* at(ConfigurationPropertyPath const& path) override;
+    ConfigurationPropertyInterface const* at(ConfigurationPropertyPath const& path) const override;
 
     bool const& get() const override;
     void set(bool const& value) override;
@@ -113,6 +122,7 @@ template<class T> class RangeConfigurationProperty final : public ConfigurationP
     ConfigurationPropertyInterface* clone() const override;
 
     ConfigurationPropertyInterface* at(ConfigurationPropertyPath const& path) override;
+    ConfigurationPropertyInterface const* at(ConfigurationPropertyPath const& path) const override;
 
     T const& get() const override;
     void set(T const& lower, T const& upper);
@@ -145,6 +155,7 @@ public:
     ConfigurationPropertyInterface* clone() const override;
 
     ConfigurationPropertyInterface* at(ConfigurationPropertyPath const& path) override;
+    ConfigurationPropertyInterface const* at(ConfigurationPropertyPath const& path) const override;
 
     T const& get() const override;
     void set(T const& value) override;
@@ -159,12 +170,16 @@ private:
 };
 
 //! \brief A property that specifies a set of distinct values from handle class \a T
-//! \details This can be used either for an enum or for distinct objects of a class or handle class
+//! \details This can be used either for an enum or for distinct objects of a class or handle class. The objects are
+//! shared between copies of the property, and the object held is cloned the first time its properties are modified
+//! by a copy, which requires the interface of the handle to define the clone() method if configurable.
 template<class T> class HandleListConfigurationProperty final : public ConfigurationPropertyBase<T> {
 public:
     HandleListConfigurationProperty();
     HandleListConfigurationProperty(List<T> const& values);
     HandleListConfigurationProperty(T const& value);
+    HandleListConfigurationProperty(HandleListConfigurationProperty const& other);
+    HandleListConfigurationProperty& operator=(HandleListConfigurationProperty const& other);
 
     bool is_single() const override;
     bool is_metric(ConfigurationPropertyPath const& path) const override;
@@ -174,22 +189,32 @@ public:
     ConfigurationPropertyInterface* clone() const override;
 
     ConfigurationPropertyInterface* at(ConfigurationPropertyPath const& path) override;
+    ConfigurationPropertyInterface const* at(ConfigurationPropertyPath const& path) const override;
+    SearchableConfiguration* nested_configuration() override;
+    SearchableConfiguration const* nested_configuration() const override;
 
     T const& get() const override;
     void set(T const& value) override;
     void set(List<T> const& values);
     void set_single(ConfigurationPropertyPath const& path, int integer_value) override;
     Map<ConfigurationPropertyPath,List<int>> integer_values() const override;
+    size_t version() const override;
   protected:
     void local_set_single(int integer_value) override;
     List<int> local_integer_values() const override;
     List<shared_ptr<T>> values() const override;
+  private:
+    //! \brief Replace the single object held with a clone, unless already owned by this property
+    void _detach_value();
   private:
     List<T> _values;
+    //! \brief Whether the single object held has been cloned by this property, hence is not shared
+    bool _is_value_detached = false;
 };
 
 //! \brief A property that specifies a list of objects deriving from an interface \a T
-//! \details T must define the clone() method to support interfaces.
+//! \details T must define the clone() method to support interfaces. Objects are shared between copies of the
+//! property, and cloned only when their properties are modified.
 template<class T> class InterfaceListConfigurationProperty final : public ConfigurationPropertyBase<T> {
   public:
     InterfaceListConfigurationProperty();
@@ -204,9 +229,13 @@ template<class T> class InterfaceListConfigurationProperty final : public Config
     ConfigurationPropertyInterface* clone() const override;
 
     ConfigurationPropertyInterface* at(ConfigurationPropertyPath const& path) override;
+    ConfigurationPropertyInterface const* at(ConfigurationPropertyPath const& path) const override;
+    SearchableConfiguration* nested_configuration() override;
+    SearchableConfiguration const* nested_configuration() const override;
 
     T const& get() const override;
     Map<ConfigurationPropertyPath,List<int>> integer_values() const override;
+    size_t version() const override;
     void set(T const& value) override;
     void set(shared_ptr<T> const& value);
     void set(List<shared_ptr<T>> const& values);
@@ -215,6 +244,9 @@ template<class T> class InterfaceListConfigurationProperty final : public Config
     void local_set_single(int integer_value) override;
     List<int> local_integer_values() const override;
     List<shared_ptr<T>> values() const override;
+  private:
+    //! \brief Clone the held object if shared, before modifying its properties
+    void _detach_value();
   private:
     List<shared_ptr<T>> _values;
 };
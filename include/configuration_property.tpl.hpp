@@ -30,6 +30,7 @@
 #define PRONEST_CONFIGURATION_PROPERTY_TPL_HPP
 
 #include <ostream>
+#include <utility>
 #include <type_traits>
 #include "helper/writable.hpp"
 #include "configuration_interface.hpp"
@@ -46,10 +47,28 @@ using Helper::Pair;
 
 inline bool possibly(bool value) { return value; }
 
-template<class T> ConfigurationPropertyBase<T>::ConfigurationPropertyBase(bool const& is_specified) : _is_specified(is_specified) { }
+template<class T> ConfigurationPropertyBase<T>::ConfigurationPropertyBase(bool const& is_specified)
+    : _is_specified(is_specified), _version(ConfigurationPropertyInterface::next_version()) { }
 
 template<class T> void ConfigurationPropertyBase<T>::set_specified() {
     _is_specified = true;
+    update_version();
+}
+
+template<class T> void ConfigurationPropertyBase<T>::update_version() {
+    _version = ConfigurationPropertyInterface::next_version();
+}
+
+template<class T> size_t ConfigurationPropertyBase<T>::version() const {
+    return _version;
+}
+
+template<class T> SearchableConfiguration* ConfigurationPropertyBase<T>::nested_configuration() {
+    return nullptr;
+}
+
+template<class T> SearchableConfiguration const* ConfigurationPropertyBase<T>::nested_configuration() const {
+    return nullptr;
 }
 
 template<class T> bool ConfigurationPropertyBase<T>::is_specified() const {
@@ -139,6 +158,7 @@ template<class T> void RangeConfigurationProperty<T>::local_set_single(int integ
     if (integer_value == min_value) _upper = _lower; // Avoids rounding error
     else if (integer_value == max_value) _lower = _upper; // Avoids rounding error
     else { _lower = _upper = _converter->from_int(integer_value); }
+    this->update_version();
 }
 
 template<class T> ConfigurationPropertyInterface* RangeConfigurationProperty<T>::clone() const {
@@ -150,6 +170,11 @@ template<class T> ConfigurationPropertyInterface* RangeConfigurationProperty<T>:
     return this;
 }
 
+template<class T> ConfigurationPropertyInterface const* RangeConfigurationProperty<T>::at(ConfigurationPropertyPath const& path) const {
+    HELPER_ASSERT_MSG(path.is_root(),"The path " << path << " is not a root but a range property can't have configurable objects below.");
+    return this;
+}
+
 template<class T> void RangeConfigurationProperty<T>::set(T const& lower, T const& upper) {
     HELPER_PRECONDITION(not possibly(upper < lower));
     this->set_specified();
@@ -226,6 +251,7 @@ template<class T> void EnumConfigurationProperty<T>::local_set_single(int intege
     T value = *iter;
     _values.clear();
     _values.insert(value);
+    this->update_version();
 }
 
 template<class T> ConfigurationPropertyInterface* EnumConfigurationProperty<T>::clone() const {
@@ -237,6 +263,11 @@ template<class T> ConfigurationPropertyInterface* EnumConfigurationProperty<T>::
     return this;
 }
 
+template<class T> ConfigurationPropertyInterface const* EnumConfigurationProperty<T>::at(ConfigurationPropertyPath const& path) const {
+    HELPER_ASSERT_MSG(path.is_root(),"The path " << path << " is not a root but an enum property can't have configurable objects below.");
+    return this;
+}
+
 template<class T> T const& EnumConfigurationProperty<T>::get() const {
     HELPER_PRECONDITION(this->is_specified());
     HELPER_ASSERT_MSG(this->is_single(),"The property should have a single value when actually used. Are you accessing it outside the related task?");
@@ -275,6 +306,17 @@ template<class T> HandleListConfigurationProperty<T>::HandleListConfigurationPro
         _values.push_back(value);
 }
 
+template<class T> HandleListConfigurationProperty<T>::HandleListConfigurationProperty(HandleListConfigurationProperty const& other)
+    : ConfigurationPropertyBase<T>(other), _values(other._values), _is_value_detached(false)
+{ }
+
+template<class T> HandleListConfigurationProperty<T>& HandleListConfigurationProperty<T>::operator=(HandleListConfigurationProperty const& other) {
+    ConfigurationPropertyBase<T>::operator=(other);
+    _values = other._values;
+    _is_value_detached = false;
+    return *this;
+}
+
 template<class T> bool HandleListConfigurationProperty<T>::is_single() const {
     return (_values.size() == 1);
 }
@@ -283,7 +325,7 @@ template<class T> bool HandleListConfigurationProperty<T>::is_metric(Configurati
     if (path.is_root()) return false;
     if (is_configurable()) {
         HELPER_PRECONDITION(is_single());
-        auto properties = dynamic_cast<const ConfigurableInterface*>(_values.at(0).const_pointer())->searchable_configuration().properties();
+        auto const properties = dynamic_cast<const ConfigurableInterface*>(_values.at(0).const_pointer())->searchable_configuration().properties();
         auto p_ptr = properties.find(path.first());
         if (p_ptr != properties.end()) {
             return p_ptr->second->is_metric(path.subpath());
@@ -318,6 +360,8 @@ template<class T> void HandleListConfigurationProperty<T>::local_set_single(int
     T value = _values[(size_t)integer_value];
     _values.clear();
     _values.push_back(value);
+    _is_value_detached = false;
+    this->update_version();
 }
 
 template<class T> void HandleListConfigurationProperty<T>::set_single(ConfigurationPropertyPath const& path, int integer_value) {
@@ -325,12 +369,13 @@ template<class T> void HandleListConfigurationProperty<T>::set_single(Configurat
         local_set_single(integer_value);
     } else { // NOTE : we assume that we already checked for being single when getting the integer_values
         bool been_set = false;
-        auto configurable_interface_ptr = dynamic_cast<ConfigurableInterface*>(_values.at(0).pointer());
-        if (configurable_interface_ptr != nullptr) {
-            auto properties = configurable_interface_ptr->searchable_configuration().properties();
-            auto p_ptr = properties.find(path.first());
-            if (p_ptr != properties.end()) {
-                p_ptr->second->set_single(path.subpath(),integer_value);
+        if (dynamic_cast<ConfigurableInterface const*>(_values.at(0).const_pointer()) != nullptr) {
+            _detach_value();
+            auto configurable_interface_ptr = dynamic_cast<ConfigurableInterface*>(_values.at(0).pointer());
+            auto& configuration = configurable_interface_ptr->mutable_searchable_configuration();
+            auto const properties = std::as_const(configuration).properties();
+            if (properties.find(path.first()) != properties.end()) {
+                configuration.set_single(path,integer_value);
                 been_set = true;
             }
         }
@@ -344,18 +389,23 @@ template<class T> Map<ConfigurationPropertyPath,List<int>> HandleListConfigurati
     if (is_single()) { // NOTE: we could extend to multiple values by using indexes
         auto configurable_interface_ptr = dynamic_cast<const ConfigurableInterface*>(_values.at(0).const_pointer());
         if (configurable_interface_ptr != nullptr) {
-            for (auto const& p : configurable_interface_ptr->searchable_configuration().properties()) {
-                for (auto const& entry : p.second->integer_values()) {
-                    auto prefixed_path = entry.first;
-                    prefixed_path.prepend(p.first);
-                    result.insert(Pair<ConfigurationPropertyPath,List<int>>(prefixed_path,entry.second));
-                }
-            }
+            for (auto const& entry : configurable_interface_ptr->searchable_configuration().integer_values())
+                result.insert(entry);
         }
     }
     return result;
 }
 
+template<class T> size_t HandleListConfigurationProperty<T>::version() const {
+    auto result = ConfigurationPropertyBase<T>::version();
+    if (is_single()) {
+        auto configurable_interface_ptr = dynamic_cast<const ConfigurableInterface*>(_values.at(0).const_pointer());
+        if (configurable_interface_ptr != nullptr)
+            result = max(result, configurable_interface_ptr->searchable_configuration().version());
+    }
+    return result;
+}
+
 template<class T> ConfigurationPropertyInterface* HandleListConfigurationProperty<T>::clone() const {
     return new HandleListConfigurationProperty(*this);
 }
@@ -365,14 +415,34 @@ template<class T> ConfigurationPropertyInterface* HandleListConfigurationPropert
     else {
         HELPER_ASSERT_MSG(is_configurable(),"The object held is not configurable, path error.");
         HELPER_ASSERT_MSG(is_single(),"Cannot retrieve properties if the list has multiple objects.");
+        _detach_value();
         auto configurable_ptr = dynamic_cast<ConfigurableInterface*>(_values.at(0).pointer());
-        auto properties = configurable_ptr->searchable_configuration().properties();
-        auto prop_ptr = properties.find(path.first());
-        HELPER_ASSERT_MSG(prop_ptr != properties.end(),"The property '" << path.first() << "' was not found in the configuration.");
-        return prop_ptr->second->at(path.subpath());
+        return &configurable_ptr->mutable_searchable_configuration().property_at(path);
+    }
+}
+
+template<class T> ConfigurationPropertyInterface const* HandleListConfigurationProperty<T>::at(ConfigurationPropertyPath const& path) const {
+    if (path.is_root()) return this;
+    else {
+        HELPER_ASSERT_MSG(is_configurable(),"The object held is not configurable, path error.");
+        HELPER_ASSERT_MSG(is_single(),"Cannot retrieve properties if the list has multiple objects.");
+        auto configurable_ptr = dynamic_cast<ConfigurableInterface const*>(_values.at(0).const_pointer());
+        return &configurable_ptr->searchable_configuration().property_at(path);
     }
 }
 
+template<class T> SearchableConfiguration* HandleListConfigurationProperty<T>::nested_configuration() {
+    if (_values.size() != 1 or dynamic_cast<ConfigurableInterface const*>(_values.at(0).const_pointer()) == nullptr) return nullptr;
+    _detach_value();
+    return &dynamic_cast<ConfigurableInterface*>(_values.at(0).pointer())->mutable_searchable_configuration();
+}
+
+template<class T> SearchableConfiguration const* HandleListConfigurationProperty<T>::nested_configuration() const {
+    if (_values.size() != 1) return nullptr;
+    auto configurable_ptr = dynamic_cast<ConfigurableInterface const*>(_values.at(0).const_pointer());
+    return (configurable_ptr != nullptr ? &configurable_ptr->searchable_configuration() : nullptr);
+}
+
 template<class T> T const& HandleListConfigurationProperty<T>::get() const {
     HELPER_PRECONDITION(this->is_specified());
     HELPER_ASSERT_MSG(this->is_single(),"The property should have a single value when actually used. Are you accessing it outside the related task?");
@@ -383,12 +453,14 @@ template<class T> void HandleListConfigurationProperty<T>::set(T const& value) {
     this->set_specified();
     _values.clear();
     _values.push_back(value);
+    _is_value_detached = false;
 }
 
 template<class T> void HandleListConfigurationProperty<T>::set(List<T> const& values) {
     HELPER_PRECONDITION(not values.empty());
     this->set_specified();
     _values = values;
+    _is_value_detached = false;
 }
 
 template<class T> List<shared_ptr<T>> HandleListConfigurationProperty<T>::values() const {
@@ -397,6 +469,16 @@ template<class T> List<shared_ptr<T>> HandleListConfigurationProperty<T>::values
     return result;
 }
 
+template<class T> void HandleListConfigurationProperty<T>::_detach_value() {
+    if (_is_value_detached) return;
+    if constexpr (requires(T const& t) { T(shared_ptr<typename T::Interface>(t.const_pointer()->clone())); }) {
+        _values.back() = T(shared_ptr<typename T::Interface>(_values.back().const_pointer()->clone()));
+        _is_value_detached = true;
+    } else {
+        HELPER_FAIL_MSG("The object held must be cloned before modifying its properties, but its interface has no clone() method.");
+    }
+}
+
 template<class T> InterfaceListConfigurationProperty<T>::InterfaceListConfigurationProperty() : ConfigurationPropertyBase<T>(false) { }
 
 template<class T> InterfaceListConfigurationProperty<T>::InterfaceListConfigurationProperty(List<shared_ptr<T>> const& list) : ConfigurationPropertyBase<T>(true), _values(list) {
@@ -415,7 +497,7 @@ template<class T> bool InterfaceListConfigurationProperty<T>::is_metric(Configur
     if (path.is_root()) return false;
     if (is_configurable()) {
         HELPER_PRECONDITION(is_single());
-        auto properties = dynamic_cast<ConfigurableInterface*>(_values.back().get())->searchable_configuration().properties();
+        auto const properties = dynamic_cast<ConfigurableInterface const*>(_values.back().get())->searchable_configuration().properties();
         auto p_ptr = properties.find(path.first());
         if (p_ptr != properties.end()) {
             return p_ptr->second->is_metric(path.subpath());
@@ -450,6 +532,7 @@ template<class T> void InterfaceListConfigurationProperty<T>::local_set_single(i
     shared_ptr<T> value = _values[(size_t)integer_value];
     _values.clear();
     _values.push_back(value);
+    this->update_version();
 }
 
 template<class T> void InterfaceListConfigurationProperty<T>::set_single(ConfigurationPropertyPath const& path, int integer_value) {
@@ -457,12 +540,12 @@ template<class T> void InterfaceListConfigurationProperty<T>::set_single(Configu
         local_set_single(integer_value);
     } else { // NOTE : we assume that we already checked for being single when getting the integer_values
         bool been_set = false;
-        auto configurable_interface_ptr = dynamic_cast<ConfigurableInterface*>(_values.back().get());
-        if (configurable_interface_ptr != nullptr) {
-            auto properties = configurable_interface_ptr->searchable_configuration().properties();
-            auto p_ptr = properties.find(path.first());
-            if (p_ptr != properties.end()) {
-                p_ptr->second->set_single(path.subpath(),integer_value);
+        if (dynamic_cast<ConfigurableInterface const*>(_values.back().get()) != nullptr) {
+            _detach_value();
+            auto& configuration = dynamic_cast<ConfigurableInterface*>(_values.back().get())->mutable_searchable_configuration();
+            auto const properties = std::as_const(configuration).properties();
+            if (properties.find(path.first()) != properties.end()) {
+                configuration.set_single(path,integer_value);
                 been_set = true;
             }
         }
@@ -476,22 +559,29 @@ template<class T> Map<ConfigurationPropertyPath,List<int>> InterfaceListConfigur
     if (is_single()) { // NOTE: we could extend to multiple values by using indexes
         auto configurable_interface_ptr = dynamic_cast<ConfigurableInterface*>(_values.back().get());
         if (configurable_interface_ptr != nullptr) {
-            for (auto const& p : configurable_interface_ptr->searchable_configuration().properties()) {
-                for (auto const& entry : p.second->integer_values()) {
-                    auto prefixed_path = entry.first;
-                    prefixed_path.prepend(p.first);
-                    result.insert(Pair<ConfigurationPropertyPath,List<int>>(prefixed_path,entry.second));
-                }
-            }
+            for (auto const& entry : configurable_interface_ptr->searchable_configuration().integer_values())
+                result.insert(entry);
         }
     }
     return result;
 }
 
+template<class T> size_t InterfaceListConfigurationProperty<T>::version() const {
+    auto result = ConfigurationPropertyBase<T>::version();
+    if (is_single()) {
+        auto configurable_interface_ptr = dynamic_cast<ConfigurableInterface const*>(_values.back().get());
+        if (configurable_interface_ptr != nullptr)
+            result = max(result, configurable_interface_ptr->searchable_configuration().version());
+    }
+    return result;
+}
+
 template<class T> ConfigurationPropertyInterface* InterfaceListConfigurationProperty<T>::clone() const {
-    List<shared_ptr<T>> values;
-    for (auto const& ptr : _values) values.push_back(shared_ptr<T>(ptr->clone()));
-    return new InterfaceListConfigurationProperty(values);
+    return new InterfaceListConfigurationProperty(*this);
+}
+
+template<class T> void InterfaceListConfigurationProperty<T>::_detach_value() {
+    if (_values.back().use_count() > 1) _values.back() = shared_ptr<T>(_values.back()->clone());
 }
 
 template<class T> ConfigurationPropertyInterface* InterfaceListConfigurationProperty<T>::at(ConfigurationPropertyPath const& path) {
@@ -499,14 +589,34 @@ template<class T> ConfigurationPropertyInterface* InterfaceListConfigurationProp
     else {
         HELPER_ASSERT_MSG(is_configurable(),"The object held is not configurable, path error.");
         HELPER_ASSERT_MSG(is_single(),"Cannot retrieve properties if the list has multiple objects.");
+        _detach_value();
         auto configurable_ptr = dynamic_cast<ConfigurableInterface*>(_values.back().get());
-        auto properties = configurable_ptr->searchable_configuration().properties();
-        auto prop_ptr = properties.find(path.first());
-        HELPER_ASSERT_MSG(prop_ptr != properties.end(),"The property '" << path.first() << "' was not found in the configuration.");
-        return prop_ptr->second->at(path.subpath());
+        return &configurable_ptr->mutable_searchable_configuration().property_at(path);
     }
 }
 
+template<class T> ConfigurationPropertyInterface const* InterfaceListConfigurationProperty<T>::at(ConfigurationPropertyPath const& path) const {
+    if (path.is_root()) return this;
+    else {
+        HELPER_ASSERT_MSG(is_configurable(),"The object held is not configurable, path error.");
+        HELPER_ASSERT_MSG(is_single(),"Cannot retrieve properties if the list has multiple objects.");
+        auto configurable_ptr = dynamic_cast<ConfigurableInterface const*>(_values.back().get());
+        return &configurable_ptr->searchable_configuration().property_at(path);
+    }
+}
+
+template<class T> SearchableConfiguration* InterfaceListConfigurationProperty<T>::nested_configuration() {
+    if (_values.size() != 1 or dynamic_cast<ConfigurableInterface const*>(_values.back().get()) == nullptr) return nullptr;
+    _detach_value();
+    return &dynamic_cast<ConfigurableInterface*>(_values.back().get())->mutable_searchable_configuration();
+}
+
+template<class T> SearchableConfiguration const* InterfaceListConfigurationProperty<T>::nested_configuration() const {
+    if (_values.size() != 1) return nullptr;
+    auto configurable_ptr = dynamic_cast<ConfigurableInterface const*>(_values.back().get());
+    return (configurable_ptr != nullptr ? &configurable_ptr->searchable_configuration() : nullptr);
+}
+
 template<class T> T const& InterfaceListConfigurationProperty<T>::get() const {
     HELPER_PRECONDITION(this->is_specified());
     HELPER_ASSERT_MSG(this->is_single(),"The property should have a single value when actually used. Are you accessing it outside the related task?");
@@ -0,0 +1,105 @@
+/***************************************************************************
+ *            configuration_property_handle.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_property_handle.hpp
+ *  \brief Class for accessing a property of a configuration without lookup by name.
+ */
+
+#ifndef PRONEST_CONFIGURATION_PROPERTY_HANDLE_HPP
+#define PRONEST_CONFIGURATION_PROPERTY_HANDLE_HPP
+
+#include <typeindex>
+#include "helper/macros.hpp"
+#include "helper/container.hpp"
+#include "configuration_property_path.hpp"
+#include "configuration_property_interface.hpp"
+#include "searchable_configuration.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+
+//! \brief A handle to a property of class \a P at a path, resolved once on a configuration
+//! \details The handle stores the ordinal of the property at each level of nesting, along with the class and the
+//! structure identity of the configuration at that level. Hence it can be used on the configuration it was resolved on
+//! and on its copies, as long as no property is added or replaced along the path. Access then involves no string
+//! comparison, path copy or dynamic cast.
+template<class P> class ConfigurationPropertyHandle {
+  public:
+    //! \brief Resolve the \a path on the \a configuration
+    ConfigurationPropertyHandle(SearchableConfiguration const& configuration, ConfigurationPropertyPath const& path)
+        : _path(path) {
+        HELPER_PRECONDITION(not path.is_root());
+        SearchableConfiguration const* current = &configuration;
+        ConfigurationPropertyInterface const* property = nullptr;
+        for (auto remaining = path; not remaining.is_root(); remaining = remaining.subpath()) {
+            HELPER_ASSERT_MSG(current != nullptr,"The property before " << remaining << " does not hold a single configurable object.");
+            _types.push_back(typeid(*current));
+            _schemas.push_back(current->_schema);
+            _ordinals.push_back(current->_ordinal(remaining.first()));
+            property = current->_ordered_properties[_ordinals.back()]->get();
+            current = property->nested_configuration();
+        }
+        HELPER_ASSERT_MSG(dynamic_cast<P const*>(property) != nullptr, "Invalid property cast, check the property class with respect to the configuration created.");
+    }
+
+    //! \brief The path of the property
+    ConfigurationPropertyPath const& path() const { return _path; }
+
+    //! \brief The property in the \a configuration, for reading only
+    P const& get(SearchableConfiguration const& configuration) const {
+        SearchableConfiguration const* current = &configuration;
+        for (size_t i=0; ; ++i) {
+            HELPER_PRECONDITION(current != nullptr and current->_schema == _schemas[i] and std::type_index(typeid(*current)) == _types[i]);
+            auto const* property = current->_ordered_properties[_ordinals[i]]->get();
+            if (i+1 == _ordinals.size()) return static_cast<P const&>(*property);
+            current = property->nested_configuration();
+        }
+    }
+
+    //! \brief The property in the \a configuration for modification, detaching any shared property along the path
+    P& get(SearchableConfiguration& configuration) const {
+        SearchableConfiguration* current = &configuration;
+        for (size_t i=0; ; ++i) {
+            HELPER_PRECONDITION(current != nullptr and current->_schema == _schemas[i] and std::type_index(typeid(*current)) == _types[i]);
+            auto* property = current->_detached_property(_ordinals[i]).get();
+            if (i+1 == _ordinals.size()) return static_cast<P&>(*property);
+            current = property->nested_configuration();
+        }
+    }
+
+  private:
+    ConfigurationPropertyPath _path;
+    List<size_t> _ordinals;
+    List<std::type_index> _types;
+    List<size_t> _schemas;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_PROPERTY_HANDLE_HPP
@@ -43,6 +43,7 @@ using Helper::Map;
 using Helper::WritableInterface;
 
 class ConfigurationPropertyPath;
+class SearchableConfiguration;
 
 class ConfigurationPropertyInterface : public WritableInterface {
   public:
@@ -58,13 +59,31 @@ class ConfigurationPropertyInterface : public WritableInterface {
     //! \details Returns 1 if single, 0 if not specified.
     virtual size_t cardinality() const = 0;
     //! \brief Set to a single value a given path, starting from this property
-    //! \details Supports the storage of objects that are Configurable themselves
+    //! \details Supports the storage of objects that are Configurable themselves, which are detached first if shared
     virtual void set_single(ConfigurationPropertyPath const& path, int integer_value) = 0;
     //! \brief The integer values for each property including the current one
     //! \details Supports the storage of objects that are Configurable themselves
     virtual Map<ConfigurationPropertyPath,List<int>> integer_values() const = 0;
     //! \brief Retrieve a pointer to the property at the given \a path
+    //! \details Any object shared with other properties along the path is detached first, to allow modification
     virtual ConfigurationPropertyInterface* at(ConfigurationPropertyPath const& path) = 0;
+    //! \brief Retrieve a pointer to the property at the given \a path, for reading only
+    virtual ConfigurationPropertyInterface const* at(ConfigurationPropertyPath const& path) const = 0;
+    //! \brief The configuration of the object held, if single and configurable, nullptr otherwise
+    //! \details Any object shared with other properties is detached first, to allow modification
+    virtual SearchableConfiguration* nested_configuration() = 0;
+    //! \brief The configuration of the object held, if single and configurable, nullptr otherwise
+    virtual SearchableConfiguration const* nested_configuration() const = 0;
+
+    //! \brief The version of the state of the property, including any nested property
+    //! \details Versions are drawn from a process-wide increasing counter on each modification, hence a change
+    //! of state anywhere results in a version greater than any previous one.
+    virtual size_t version() const = 0;
+    //! \brief The latest version drawn
+    //! \details If unchanged, no property has been modified in the meantime.
+    static size_t latest_version();
+    //! \brief Draw a new version, greater than any previous one
+    static size_t next_version();
 
     virtual ConfigurationPropertyInterface* clone() const = 0;
     virtual ~ConfigurationPropertyInterface() = default;
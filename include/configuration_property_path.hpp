@@ -34,39 +34,60 @@
 #define PRONEST_CONFIGURATION_PROPERTY_PATH_HPP
 
 #include <utility>
-#include <deque>
+#include <string_view>
+#include <functional>
 #include "helper/string.hpp"
 
 namespace ProNest {
 
 using Helper::String;
 
+struct ConfigurationPropertyPathEntry;
+
+//! \brief A path of property names
+//! \details Paths are interned in a process-wide table, hence a path object is just a reference to an immutable entry.
+//! Equality and hashing are constant time, while ordering is lexicographic on the representation but performs
+//! no allocation. Modifying a path (append, prepend, subpath) re-interns the result.
 class ConfigurationPropertyPath {
   public:
-    ConfigurationPropertyPath() = default;
+    ConfigurationPropertyPath();
     ConfigurationPropertyPath(String const& first);
     ConfigurationPropertyPath(ConfigurationPropertyPath const& path);
     ConfigurationPropertyPath& operator=(ConfigurationPropertyPath const& path);
     bool operator==(ConfigurationPropertyPath const& path) const;
     bool operator<(ConfigurationPropertyPath const& path) const;
 
-    String repr() const;
+    //! \brief Parse from nodes separated by '/', e.g. "a/b/c"
+    //! \details Empty and "." nodes are ignored, hence the result of repr() is parsed back into the same path.
+    static ConfigurationPropertyPath parse(std::string_view const& str);
+
+    String const& repr() const;
+    //! \brief The hash of the path, precomputed when interning
+    size_t hash() const;
+    //! \brief An identifier that is unique for the path within the process
+    size_t id() const;
 
     bool is_root() const;
     ConfigurationPropertyPath& append(String const& node);
     ConfigurationPropertyPath& prepend(String const& node);
     //! \brief Return the first level of the path
-    String first() const;
+    String const& first() const;
     //! \brief Return the last level of the path
-    String last() const;
+    String const& last() const;
     //! \brief Return everything but the first level of the path
     ConfigurationPropertyPath subpath() const;
 
     friend std::ostream& operator<<(std::ostream& os, ConfigurationPropertyPath const& path);
   private:
-    std::deque<String> _path;
+    ConfigurationPropertyPath(ConfigurationPropertyPathEntry const* entry);
+  private:
+    ConfigurationPropertyPathEntry const* _entry;
 };
 
 } // namespace ProNest
 
+template<> struct std::hash<ProNest::ConfigurationPropertyPath> {
+    size_t operator()(ProNest::ConfigurationPropertyPath const& path) const noexcept { return path.hash(); }
+};
+
 #endif // PRONEST_CONFIGURATION_PROPERTY_PATH_HPP
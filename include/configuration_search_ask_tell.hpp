@@ -0,0 +1,112 @@
+/***************************************************************************
+ *            include/configuration_search_ask_tell.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_ask_tell.hpp
+ *  \brief Classes for searches driven by asking for points and telling their costs.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_ASK_TELL_HPP
+#define PRONEST_CONFIGURATION_SEARCH_ASK_TELL_HPP
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include "helper/container.hpp"
+#include "configuration_search_space.hpp"
+#include "configuration_search_point.hpp"
+#include "configuration_search_sampling.hpp"
+#include "random_engine.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+
+//! \brief A search where the caller evaluates the points, asking for points to evaluate and telling their costs
+//! \details Costs can be told in any order and at any time after the point has been asked, hence the evaluations can
+//! run in external queues. The points asked are distinct, and their number is bounded by the budget. A search may
+//! return fewer points than asked, or none, if it needs the costs of pending points before proposing more.
+//! The search has finished when no more points will be asked and all the points asked have been told.
+//! An optimiser is not safe to use concurrently: see ConfigurationSearchAskTellDriver for that purpose.
+class ConfigurationSearchAskTellOptimiser {
+  public:
+    ConfigurationSearchAskTellOptimiser(ConfigurationSearchSpace const& space, size_t budget);
+    virtual ~ConfigurationSearchAskTellOptimiser() = default;
+
+    //! \brief Up to \a amount new points to evaluate
+    List<ConfigurationSearchPoint> ask(size_t amount);
+    //! \brief Report the \a cost of a \a point previously asked and not yet told
+    void tell(ConfigurationSearchPoint const& point, double cost);
+    //! \brief Whether no more points will be asked and none is pending
+    bool is_finished() const;
+
+    ConfigurationSearchSpace const& space() const;
+    //! \brief The maximum number of points asked
+    size_t budget() const;
+    size_t num_asked() const;
+    size_t num_told() const;
+    //! \brief The number of points asked and not yet told
+    size_t num_pending() const;
+
+    //! \brief Whether any cost has been told
+    bool has_best() const;
+    //! \brief The point told with the lowest cost, the earliest told on ties
+    ConfigurationSearchPoint const& best() const;
+    double best_cost() const;
+
+  protected:
+    //! \brief Up to \a amount points never asked before, returning none only if waiting for pending costs or exhausted
+    virtual List<ConfigurationSearchPoint> propose(size_t amount) = 0;
+    //! \brief Update the search with the \a cost told for \a point
+    virtual void observe(ConfigurationSearchPoint const& point, double cost) = 0;
+
+    //! \brief Whether \a point has been asked, either pending or told
+    bool is_asked(ConfigurationSearchPoint const& point) const;
+    //! \brief The cost of \a point, if told
+    std::optional<double> told_cost(ConfigurationSearchPoint const& point) const;
+
+  private:
+    ConfigurationSearchSpace _space;
+    size_t _budget;
+    std::unordered_set<ConfigurationSearchPoint> _pending;
+    std::unordered_map<ConfigurationSearchPoint,double> _told;
+    std::optional<ConfigurationSearchPoint> _best;
+    double _best_cost;
+    //! \brief Whether the search returned no point while none was pending, hence cannot propose any more
+    bool _is_exhausted;
+};
+
+//! \brief A search asking for the points of a sample of \a budget points of \a space, with the given \a sampling
+//! \details The engine of the search is split from \a engine
+std::shared_ptr<ConfigurationSearchAskTellOptimiser> make_sampled_ask_tell(ConfigurationSearchSpace const& space, size_t budget,
+                                                                           ConfigurationSearchSampling sampling,
+                                                                           RandomEngine& engine = RandomEngine::thread_engine());
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_ASK_TELL_HPP
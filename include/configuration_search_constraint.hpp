@@ -0,0 +1,92 @@
+/***************************************************************************
+ *            configuration_search_constraint.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_constraint.hpp
+ *  \brief Class for handling constraints between configuration search parameters.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_CONSTRAINT_HPP
+#define PRONEST_CONFIGURATION_SEARCH_CONSTRAINT_HPP
+
+#include <functional>
+#include <memory>
+#include "helper/container.hpp"
+#include "helper/string.hpp"
+#include "configuration_property_path.hpp"
+
+namespace ProNest {
+
+using std::ostream;
+using Helper::List;
+using Helper::Map;
+using Helper::Pair;
+using Helper::String;
+
+//! \brief A condition that the values of some search parameters must satisfy for a point to be feasible
+//! \details The predicate receives the values of the parameters ordered as the \a paths. Since the predicate cannot be
+//! compared, it is shared by the copies of a constraint, which are identified by the predicate object along with the
+//! paths and description: constructing twice from the same lambda gives two different constraints.
+class ConfigurationSearchConstraint {
+  public:
+    using Predicate = std::function<bool(List<int> const&)>;
+
+    ConfigurationSearchConstraint(String const& description, List<ConfigurationPropertyPath> const& paths, Predicate const& predicate);
+
+    //! \brief The constraint that the value of \a lower is not greater than the value of \a upper
+    static ConfigurationSearchConstraint less_or_equal(ConfigurationPropertyPath const& lower, ConfigurationPropertyPath const& upper);
+
+    String const& description() const;
+    //! \brief The paths of the parameters involved
+    List<ConfigurationPropertyPath> const& paths() const;
+    //! \brief Whether the \a values, ordered as the paths, satisfy the constraint
+    bool is_satisfied_by(List<int> const& values) const;
+
+    //! \brief The constraint on the remaining paths, once the paths in \a values are fixed to the given values
+    //! \details Used when some of the paths are single-valued properties rather than parameters. At least one path
+    //! must remain free. The result keeps the predicate of this constraint, and equals any other binding of the same
+    //! paths to the same values.
+    ConfigurationSearchConstraint bind(Map<ConfigurationPropertyPath,int> const& values) const;
+
+    bool operator==(ConfigurationSearchConstraint const& other) const;
+
+    friend ostream& operator<<(ostream& os, ConfigurationSearchConstraint const& constraint);
+
+  private:
+    //! \brief Construct sharing an existing \a predicate, for constraints with the same identity
+    ConfigurationSearchConstraint(String const& description, List<ConfigurationPropertyPath> const& paths, std::shared_ptr<Predicate const> const& predicate);
+  private:
+    String _description;
+    List<ConfigurationPropertyPath> _paths;
+    std::shared_ptr<Predicate const> _predicate;
+    //! \brief The values fixed by binding, with their position among the values of the predicate
+    List<Pair<size_t,int>> _bound_values;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_CONSTRAINT_HPP
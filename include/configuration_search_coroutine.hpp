@@ -0,0 +1,135 @@
+/***************************************************************************
+ *            include/configuration_search_coroutine.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_coroutine.hpp
+ *  \brief Awaitables for driving ask/tell searches from coroutines.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_COROUTINE_HPP
+#define PRONEST_CONFIGURATION_SEARCH_COROUTINE_HPP
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include <condition_variable>
+#include "configuration_search_ask_tell.hpp"
+
+namespace ProNest {
+
+//! \brief The return type of a coroutine started on call and destroyed on completion
+//! \details No result is returned: the coroutine must tell its costs to a driver, and an exception escaping from it
+//! terminates the program.
+struct ConfigurationSearchTask {
+    struct promise_type {
+        ConfigurationSearchTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+//! \brief The cost of a point evaluated elsewhere, awaited by a coroutine and completed from any thread
+//! \details Copies refer to the same result, hence a copy can be handed to the evaluation while the original is
+//! awaited. The awaiting coroutine is resumed on the thread that completes, or immediately if already completed.
+class ConfigurationSearchCompletion {
+  public:
+    ConfigurationSearchCompletion();
+
+    //! \brief Set the \a cost, to be done once
+    void complete(double cost);
+    //! \brief Set an \a error to be thrown when awaiting, instead of a cost
+    void fail(std::exception_ptr error);
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle);
+    double await_resume();
+
+  private:
+    void _resolve(std::optional<double> cost, std::exception_ptr error);
+
+    struct State {
+        std::mutex mutex;
+        bool is_resolved = false;
+        std::optional<double> cost;
+        std::exception_ptr error;
+        std::coroutine_handle<> waiter;
+    };
+    std::shared_ptr<State> _state;
+};
+
+//! \brief Thread-safe access to an ask/tell search, for coroutines awaiting points
+//! \details Awaiting ask() yields a point to evaluate, or nothing once the search has finished. When the search
+//! needs pending costs before proposing more points, the coroutine is suspended without blocking its thread, and is
+//! resumed by a later tell() on the thread calling it. Hence a few threads completing evaluations can drive any
+//! number of coroutines, each looping over asking, awaiting an evaluation and telling its cost.
+class ConfigurationSearchAskTellDriver {
+  public:
+    //! \brief The awaitable returned by ask()
+    class AskAwaitable {
+        friend class ConfigurationSearchAskTellDriver;
+      public:
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        std::optional<ConfigurationSearchPoint> await_resume() { return std::move(_point); }
+      private:
+        explicit AskAwaitable(ConfigurationSearchAskTellDriver& driver) : _driver(driver) { }
+        ConfigurationSearchAskTellDriver& _driver;
+        std::coroutine_handle<> _handle;
+        std::optional<ConfigurationSearchPoint> _point;
+    };
+
+    explicit ConfigurationSearchAskTellDriver(std::shared_ptr<ConfigurationSearchAskTellOptimiser> optimiser);
+
+    //! \brief Await a point to evaluate, or nothing if the search has finished
+    AskAwaitable ask();
+    //! \brief Tell the \a cost of \a point, then resume the coroutines waiting for points that can now be served
+    void tell(ConfigurationSearchPoint const& point, double cost);
+
+    //! \brief Block until the search has finished
+    void wait() const;
+
+    bool is_finished() const;
+    //! \brief The number of coroutines waiting for a point
+    size_t num_waiting() const;
+    ConfigurationSearchPoint best() const;
+    double best_cost() const;
+
+  private:
+    std::shared_ptr<ConfigurationSearchAskTellOptimiser> _optimiser;
+    mutable std::mutex _mutex;
+    mutable std::condition_variable _finished;
+    std::deque<AskAwaitable*> _waiting;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_COROUTINE_HPP
@@ -0,0 +1,95 @@
+/***************************************************************************
+ *            configuration_search_evaluation_cache.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_evaluation_cache.hpp
+ *  \brief Class for caching the costs of evaluated search points.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_EVALUATION_CACHE_HPP
+#define PRONEST_CONFIGURATION_SEARCH_EVALUATION_CACHE_HPP
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include "configuration_search_point.hpp"
+
+namespace ProNest {
+
+//! \brief Counters of the accesses to a ConfigurationSearchEvaluationCache
+struct ConfigurationSearchEvaluationCacheStatistics {
+    size_t hits;
+    size_t misses;
+    //! \brief The number of entries removed to respect the capacity
+    size_t evictions;
+
+    //! \brief The fraction of lookups that found an entry, zero if no lookup happened
+    double hit_rate() const { return (hits + misses == 0 ? 0.0 : static_cast<double>(hits)/static_cast<double>(hits + misses)); }
+};
+
+//! \brief A thread-safe cache of costs keyed by search point, with least-recently-used eviction
+//! \details Entries are distributed by point hash over independently locked shards, each with its own LRU order and
+//! an equal share of the capacity, so that concurrent workers rarely contend. A cache is meaningful only for a given
+//! configuration and cost function, which the caller is responsible for keeping together.
+class ConfigurationSearchEvaluationCache {
+    struct Shard;
+  public:
+    //! \brief Construct holding up to \a capacity entries, split into \a num_shards shards
+    explicit ConfigurationSearchEvaluationCache(size_t capacity, size_t num_shards = 16);
+    ~ConfigurationSearchEvaluationCache();
+
+    //! \brief The cost cached for \a point, if any, which becomes the most recently used
+    std::optional<double> find(ConfigurationSearchPoint const& point);
+    //! \brief Cache the \a cost for \a point, replacing any previous cost and evicting the least recently used if full
+    void insert(ConfigurationSearchPoint const& point, double cost);
+
+    //! \brief The number of entries
+    size_t size() const;
+    //! \brief The maximum number of entries
+    size_t capacity() const;
+    //! \brief Remove all entries, keeping the statistics
+    void clear();
+
+    ConfigurationSearchEvaluationCacheStatistics statistics() const;
+
+  private:
+    Shard& _shard(ConfigurationSearchPoint const& point) const;
+
+  private:
+    size_t const _capacity;
+    List<std::unique_ptr<Shard>> _shards;
+    std::atomic<size_t> _hits;
+    std::atomic<size_t> _misses;
+    std::atomic<size_t> _evictions;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_EVALUATION_CACHE_HPP
@@ -0,0 +1,126 @@
+/***************************************************************************
+ *            configuration_search_evaluator.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_evaluator.hpp
+ *  \brief Classes for evaluating the cost of configurations for search points in parallel.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_EVALUATOR_HPP
+#define PRONEST_CONFIGURATION_SEARCH_EVALUATOR_HPP
+
+#include <chrono>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+#include "configuration_search_point.hpp"
+#include "work_stealing_pool.hpp"
+#include "configuration_search_evaluation_cache.hpp"
+
+namespace ProNest {
+
+//! \brief The outcome of evaluating the cost of the configuration for a search point
+struct ConfigurationSearchEvaluation {
+    ConfigurationSearchPoint point;
+    double cost;
+    //! \brief The time for making the singleton configuration and evaluating its cost, or for finding it in the cache
+    std::chrono::nanoseconds duration;
+    //! \brief Whether the cost has been found in the cache instead of being evaluated
+    bool is_cached;
+};
+
+//! \brief An evaluator of costs of configurations for sets of search points, on a pool of worker threads
+//! \details The pool is kept between evaluations; each singleton configuration is made on the worker that evaluates
+//! it, hence the cost function must be safe to call concurrently. If a cache is supplied, each worker first looks
+//! for the cost of its point there, and caches the costs it evaluates; the cache must be used with only one
+//! configuration and cost function.
+class ConfigurationSearchEvaluator {
+  public:
+    //! \brief Construct with at most \a concurrency evaluations running at the same time, optionally sharing a \a cache
+    explicit ConfigurationSearchEvaluator(size_t concurrency, std::shared_ptr<ConfigurationSearchEvaluationCache> cache = nullptr)
+        : _pool(concurrency), _cache(std::move(cache)) { }
+
+    //! \brief The maximum number of evaluations running at the same time
+    size_t concurrency() const { return _pool.concurrency(); }
+    //! \brief The cache of costs, if any
+    std::shared_ptr<ConfigurationSearchEvaluationCache> const& cache() const { return _cache; }
+
+    //! \brief Evaluate the \a cost of the singleton configuration from \a cfg for each of the \a points
+    //! \return The evaluations by increasing cost, with ties in the order of \a points
+    //! \details Points not yet evaluated when \a cancellation is cancelled are omitted from the result. If the cost
+    //! function throws, the remaining points are skipped and the first exception is rethrown.
+    template<class C, class F> List<ConfigurationSearchEvaluation> evaluate(Configuration<C> const& cfg, List<ConfigurationSearchPoint> const& points, F const& cost,
+                                                                           CancellationToken const& cancellation = CancellationToken()) {
+        static_assert(std::is_convertible_v<std::invoke_result_t<F const&,Configuration<C> const&>,double>, "The cost function must return a value convertible to double.");
+        if (points.empty()) return {};
+        auto const& space = points.front().space();
+        for (auto const& p : points) HELPER_PRECONDITION(p.space() == space);
+        ConfigurationSingletonMaker<C> const maker(cfg, space);
+        return evaluate(points, [&](ConfigurationSearchPoint const& p) { return cost(maker.make(p)); }, cancellation);
+    }
+
+    //! \brief Evaluate the \a cost of each of the \a points
+    //! \return The evaluations by increasing cost, with ties in the order of \a points
+    //! \details As for configurations, with the duration covering only the cost of the point.
+    template<class F> List<ConfigurationSearchEvaluation> evaluate(List<ConfigurationSearchPoint> const& points, F const& cost,
+                                                                  CancellationToken const& cancellation = CancellationToken()) {
+        static_assert(std::is_convertible_v<std::invoke_result_t<F const&,ConfigurationSearchPoint const&>,double>, "The cost function must return a value convertible to double.");
+        List<std::optional<ConfigurationSearchEvaluation>> slots(points.size());
+        _pool.run(points.size(), [&](size_t i) {
+            auto const start = std::chrono::steady_clock::now();
+            if (_cache != nullptr) {
+                if (auto cached = _cache->find(points[i])) {
+                    slots[i].emplace(ConfigurationSearchEvaluation{points[i], *cached, std::chrono::steady_clock::now() - start, true});
+                    return;
+                }
+            }
+            double const value = static_cast<double>(cost(points[i]));
+            if (_cache != nullptr) _cache->insert(points[i], value);
+            slots[i].emplace(ConfigurationSearchEvaluation{points[i], value, std::chrono::steady_clock::now() - start, false});
+        }, cancellation);
+
+        List<ConfigurationSearchEvaluation> result;
+        result.reserve(points.size());
+        for (auto& slot : slots) if (slot.has_value()) result.push_back(std::move(*slot));
+        std::stable_sort(result.begin(), result.end(), [](auto const& a, auto const& b) { return a.cost < b.cost; });
+        return result;
+    }
+
+    //! \brief Evaluate the \a cost of the singleton configuration from \a cfg for each of the ordered \a points
+    template<class C, class F> List<ConfigurationSearchEvaluation> evaluate(Configuration<C> const& cfg, Set<ConfigurationSearchPoint> const& points, F const& cost,
+                                                                           CancellationToken const& cancellation = CancellationToken()) {
+        return evaluate(cfg, List<ConfigurationSearchPoint>(points.begin(), points.end()), cost, cancellation);
+    }
+
+  private:
+    WorkStealingPool _pool;
+    std::shared_ptr<ConfigurationSearchEvaluationCache> _cache;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_EVALUATOR_HPP
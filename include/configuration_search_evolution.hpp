@@ -0,0 +1,138 @@
+/***************************************************************************
+ *            configuration_search_evolution.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_evolution.hpp
+ *  \brief Classes for evolutionary search over the points of a search space.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_EVOLUTION_HPP
+#define PRONEST_CONFIGURATION_SEARCH_EVOLUTION_HPP
+
+#include <memory>
+#include <functional>
+#include "configuration_search_point.hpp"
+#include "configuration_search_evaluation_cache.hpp"
+#include "configuration_search_ask_tell.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace ProNest {
+
+//! \brief The way a child point inherits the coordinates of its two parents
+//! \details With UNIFORM crossover each parameter is inherited from either parent with equal probability.
+//! With PATH_PREFIX crossover the parameters are grouped in blocks having the same first nodes of their paths, up
+//! to a prefix depth, and each block is inherited as a whole. With the default depth of one, each block gathers the
+//! parameters of a property of the root configuration, however deeply nested; parameters with paths not longer than
+//! the depth form a block each.
+enum class ConfigurationSearchCrossover { UNIFORM, PATH_PREFIX };
+
+//! \brief A child of the points \a first and \a second from the same space, using \a crossover and \a engine
+//! \details The child is not checked for feasibility. The \a prefix_depth is used by PATH_PREFIX crossover.
+ConfigurationSearchPoint make_crossover(ConfigurationSearchPoint const& first, ConfigurationSearchPoint const& second, ConfigurationSearchCrossover crossover,
+                                        RandomEngine& engine = RandomEngine::thread_engine(), size_t prefix_depth = 1);
+
+//! \brief The outcome of an evolutionary search
+struct ConfigurationSearchEvolutionResult {
+    ConfigurationSearchPoint best;
+    double best_cost;
+    //! \brief The best cost in the population of each generation, starting from the initial one
+    List<double> generation_best_costs;
+    //! \brief The number of calls to the cost function, excluding costs found in the cache
+    size_t num_evaluations;
+};
+
+//! \brief An evolutionary search recombining and mutating a population of feasible points
+//! \details The initial population is a Latin hypercube sample of the space. Each generation keeps the elites, i.e.,
+//! the points of lowest cost, and fills the rest of the population with children: each child has two parents chosen
+//! by tournament, is obtained by crossover with a given probability (or else copies the first parent), and is then
+//! mutated by shifting one parameter with a given probability. Infeasible children are redrawn a few times before
+//! falling back to the first parent. The costs of each generation are evaluated in parallel by a
+//! ConfigurationSearchEvaluator, and the costs of the elites are not evaluated again.
+class ConfigurationSearchEvolution {
+  public:
+    using Cost = std::function<double(ConfigurationSearchPoint const&)>;
+
+    ConfigurationSearchEvolution(size_t population_size, size_t num_generations);
+
+    //! \brief Set the \a crossover, with the \a prefix_depth grouping the parameters for PATH_PREFIX crossover
+    void set_crossover(ConfigurationSearchCrossover crossover, size_t prefix_depth = 1);
+    //! \brief Set the probability that a child is obtained by crossover
+    void set_crossover_probability(double probability);
+    //! \brief Set the probability that a child is mutated
+    void set_mutation_probability(double probability);
+    //! \brief Set the number of points competing for each parent
+    void set_tournament_size(size_t size);
+    //! \brief Set the number of best points carried over to the next generation unchanged
+    void set_num_elites(size_t num_elites);
+    //! \brief Set the number of costs evaluated at the same time
+    void set_concurrency(size_t concurrency);
+    //! \brief Set a \a cache for the costs, to be used with only one cost function
+    void set_cache(std::shared_ptr<ConfigurationSearchEvaluationCache> cache);
+
+    size_t population_size() const;
+    size_t num_generations() const;
+
+    //! \brief Evolve points of \a space minimising \a cost, with random choices from \a engine
+    //! \details The population is capped to the points of the space. The initial population is always evaluated in
+    //! full; if \a cancellation is cancelled, the generation being evaluated is cut short and discarded, and the best
+    //! point of the previous generation is returned.
+    ConfigurationSearchEvolutionResult evolve(ConfigurationSearchSpace const& space, Cost const& cost,
+                                              RandomEngine& engine = RandomEngine::thread_engine(),
+                                              CancellationToken const& cancellation = CancellationToken()) const;
+
+    //! \brief Evolve points of the search space of \a cfg, minimising the \a cost of their singleton configurations
+    template<class C, class F> ConfigurationSearchEvolutionResult evolve(Configuration<C> const& cfg, F const& cost,
+                                                                        RandomEngine& engine = RandomEngine::thread_engine(),
+                                                                        CancellationToken const& cancellation = CancellationToken()) const {
+        auto const space = cfg.search_space();
+        ConfigurationSingletonMaker<C> const maker(cfg, space);
+        return evolve(space, [&](ConfigurationSearchPoint const& p) { return static_cast<double>(cost(maker.make(p))); }, engine, cancellation);
+    }
+
+    //! \brief A steady-state version of the search over \a space asking for up to \a budget points
+    //! \details The initial population is asked first; then each point asked is a child of the population told so far,
+    //! and each cost told replaces the worst point of the population if lower, so that costs can arrive in any order.
+    //! The number of generations, the elites, the concurrency and the cache are not used.
+    std::shared_ptr<ConfigurationSearchAskTellOptimiser> make_ask_tell(ConfigurationSearchSpace const& space, size_t budget,
+                                                                       RandomEngine& engine = RandomEngine::thread_engine()) const;
+
+  private:
+    size_t _population_size;
+    size_t _num_generations;
+    ConfigurationSearchCrossover _crossover;
+    size_t _prefix_depth;
+    double _crossover_probability;
+    double _mutation_probability;
+    size_t _tournament_size;
+    size_t _num_elites;
+    size_t _concurrency;
+    std::shared_ptr<ConfigurationSearchEvaluationCache> _cache;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_EVOLUTION_HPP
@@ -0,0 +1,99 @@
+/***************************************************************************
+ *            configuration_search_forest.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_forest.hpp
+ *  \brief Class for a random forest regression model of costs over search points.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_FOREST_HPP
+#define PRONEST_CONFIGURATION_SEARCH_FOREST_HPP
+
+#include "helper/container.hpp"
+#include "configuration_search_point.hpp"
+#include "random_engine.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+
+//! \brief A prediction of the cost of a point
+struct ConfigurationSearchPrediction {
+    double mean;
+    double variance;
+};
+
+//! \brief A random forest of regression trees predicting costs of points of a space
+//! \details Each tree is grown on a bootstrap sample of the observations, choosing each split among a random subset
+//! of the parameters. Metric parameters are split by a threshold on their value, non-metric parameters by whether
+//! they have a given value, since their order is not meaningful. The prediction is the mean of the trees, and its
+//! variance across the trees measures the uncertainty of the model.
+class ConfigurationSearchForest {
+    //! \brief A node of a tree, either a split or a leaf
+    struct Node {
+        //! \brief The parameter index of the split, or the number of parameters for a leaf
+        size_t parameter;
+        //! \brief The threshold for a metric split, or the value for a non-metric split
+        int value;
+        bool is_metric;
+        //! \brief The index of the first child, the second one following it
+        size_t children;
+        //! \brief The mean output, for a leaf
+        double output;
+    };
+    using Tree = List<Node>;
+    class TreeGrower;
+  public:
+    ConfigurationSearchForest(size_t num_trees = 16, size_t minimum_split_size = 3, size_t maximum_depth = 20);
+
+    //! \brief Add an observation of \a cost for \a point, which takes effect on the next fit
+    void add(ConfigurationSearchPoint const& point, double cost);
+    //! \brief The number of observations
+    size_t num_observations() const;
+
+    //! \brief Grow the trees on all the observations, with random choices from \a engine
+    //! \details Trees are grown on up to \a concurrency threads, with streams split from \a engine
+    void fit(RandomEngine& engine = RandomEngine::thread_engine(), size_t concurrency = 1);
+    //! \brief Whether the forest has been fitted on at least one observation
+    bool is_fitted() const;
+
+    //! \brief The prediction for \a point
+    ConfigurationSearchPrediction predict(ConfigurationSearchPoint const& point) const;
+
+  private:
+    size_t _num_trees;
+    size_t _minimum_split_size;
+    size_t _maximum_depth;
+    List<bool> _is_metric;
+    List<List<int>> _inputs;
+    List<double> _outputs;
+    List<Tree> _trees;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_FOREST_HPP
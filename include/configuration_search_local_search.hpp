@@ -0,0 +1,155 @@
+/***************************************************************************
+ *            configuration_search_local_search.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_local_search.hpp
+ *  \brief Classes for local search over the points of a search space.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_LOCAL_SEARCH_HPP
+#define PRONEST_CONFIGURATION_SEARCH_LOCAL_SEARCH_HPP
+
+#include <cmath>
+#include <memory>
+#include <functional>
+#include "configuration_search_point.hpp"
+#include "configuration_search_evaluation_cache.hpp"
+#include "configuration_search_ask_tell.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace ProNest {
+
+//! \brief Interface for the rule deciding whether a local search moves to a candidate point
+//! \details A move that does not increase the cost is always accepted, while a move increasing the cost by delta is
+//! accepted with probability exp(-delta/T) for the temperature T at the current step: a zero temperature hence
+//! accepts no increase.
+struct ConfigurationSearchAcceptanceInterface {
+    //! \brief The temperature at the given \a step of a chain
+    virtual double temperature(size_t step) const = 0;
+
+    virtual ConfigurationSearchAcceptanceInterface* clone() const = 0;
+    virtual ~ConfigurationSearchAcceptanceInterface() = default;
+};
+
+//! \brief Accept only the moves that do not increase the cost
+struct GreedyAcceptance : ConfigurationSearchAcceptanceInterface {
+    double temperature(size_t) const override { return 0.0; }
+    ConfigurationSearchAcceptanceInterface* clone() const override { return new GreedyAcceptance(*this); }
+};
+
+//! \brief Simulated annealing, with the temperature decreasing geometrically by \a cooling_factor at each step
+struct AnnealingAcceptance : ConfigurationSearchAcceptanceInterface {
+    AnnealingAcceptance(double initial_temperature, double cooling_factor) : _initial_temperature(initial_temperature), _cooling_factor(cooling_factor) {
+        HELPER_PRECONDITION(initial_temperature > 0);
+        HELPER_PRECONDITION(cooling_factor > 0 and cooling_factor <= 1);
+    }
+    double temperature(size_t step) const override { return _initial_temperature*std::pow(_cooling_factor, static_cast<double>(step)); }
+    ConfigurationSearchAcceptanceInterface* clone() const override { return new AnnealingAcceptance(*this); }
+  private:
+    double _initial_temperature;
+    double _cooling_factor;
+};
+
+//! \brief The outcome of a local search
+struct ConfigurationSearchLocalSearchResult {
+    //! \brief The best point found by any chain
+    //! \details If no cost was finite, a point evaluated first, whose cost is infinite or NaN.
+    ConfigurationSearchPoint best;
+    double best_cost;
+    //! \brief The best cost found by each chain
+    List<double> chain_best_costs;
+    //! \brief The number of calls to the cost function, excluding costs found in the cache
+    size_t num_evaluations;
+};
+
+//! \brief A local search moving between adjacent feasible points, over one or more chains running in parallel
+//! \details Each chain starts from a random point and at each step draws an adjacent point, moving to it according
+//! to the acceptance rule. With a tabu tenure, the points most recently moved to by a chain are not drawn again by it.
+//! Chains share the best point found: a chain that does not improve its best cost for a number of steps restarts from
+//! the shared best point if better than its current one, or else from a random point. With tempering, chain k runs
+//! at the temperature of the acceptance rule multiplied by ratio^k, and at regular intervals adjacent chains swap
+//! their current points with the replica exchange probability, so that cold chains exploit what hot chains explore.
+class ConfigurationSearchLocalSearch {
+  public:
+    using Cost = std::function<double(ConfigurationSearchPoint const&)>;
+
+    //! \brief Construct with the \a acceptance rule and the number of steps of each chain
+    ConfigurationSearchLocalSearch(ConfigurationSearchAcceptanceInterface const& acceptance, size_t num_steps);
+
+    //! \brief Set the number of chains, each run on its own thread
+    void set_num_chains(size_t num_chains);
+    //! \brief Set the number of recent points a chain does not draw again, zero for no tabu list
+    void set_tabu_tenure(size_t tenure);
+    //! \brief Set the number of steps without improvement after which a chain restarts, zero for never
+    void set_restart_after(size_t num_steps);
+    //! \brief Couple the chains by tempering, with the temperature \a ratio between adjacent chains and
+    //! swaps attempted every \a exchange_interval steps
+    //! \details Requires an acceptance rule with a positive temperature
+    void set_tempering(double ratio, size_t exchange_interval);
+    //! \brief Set a \a cache for the costs, to be used with only one cost function
+    void set_cache(std::shared_ptr<ConfigurationSearchEvaluationCache> cache);
+
+    size_t num_steps() const;
+    size_t num_chains() const;
+
+    //! \brief Search the points of \a space minimising \a cost, with chain engines split from \a engine
+    //! \details The chains stop early if \a cancellation is cancelled. The cost function must be safe to call
+    //! concurrently if using more than one chain.
+    ConfigurationSearchLocalSearchResult search(ConfigurationSearchSpace const& space, Cost const& cost,
+                                                RandomEngine& engine = RandomEngine::thread_engine(),
+                                                CancellationToken const& cancellation = CancellationToken()) const;
+
+    //! \brief Search the points of the search space of \a cfg, minimising the \a cost of their singleton configurations
+    template<class C, class F> ConfigurationSearchLocalSearchResult search(Configuration<C> const& cfg, F const& cost,
+                                                                          RandomEngine& engine = RandomEngine::thread_engine(),
+                                                                          CancellationToken const& cancellation = CancellationToken()) const {
+        auto const space = cfg.search_space();
+        ConfigurationSingletonMaker<C> const maker(cfg, space);
+        return search(space, [&](ConfigurationSearchPoint const& p) { return static_cast<double>(cost(maker.make(p))); }, engine, cancellation);
+    }
+
+    //! \brief A version of the search over \a space asking for up to \a budget points
+    //! \details Each chain has at most one point pending, hence at most as many points as chains are asked at a time.
+    //! Steps to points already told take their known cost without asking. The number of steps and the cache are not
+    //! used, and tempering is not supported since it requires the chains to advance together.
+    std::shared_ptr<ConfigurationSearchAskTellOptimiser> make_ask_tell(ConfigurationSearchSpace const& space, size_t budget,
+                                                                       RandomEngine& engine = RandomEngine::thread_engine()) const;
+
+  private:
+    std::shared_ptr<const ConfigurationSearchAcceptanceInterface> _acceptance;
+    size_t _num_steps;
+    size_t _num_chains;
+    size_t _tabu_tenure;
+    size_t _restart_after;
+    double _tempering_ratio;
+    size_t _exchange_interval;
+    std::shared_ptr<ConfigurationSearchEvaluationCache> _cache;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_LOCAL_SEARCH_HPP
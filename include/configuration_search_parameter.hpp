@@ -36,6 +36,7 @@
 #include "helper/container.hpp"
 #include "helper/macros.hpp"
 #include "configuration_property_path.hpp"
+#include "random_engine.hpp"
 
 namespace ProNest {
 
@@ -48,12 +49,15 @@ class ConfigurationSearchParameter {
     ConfigurationPropertyPath const& path() const;
     //! \brief Admissible values
     List<int> const& values() const;
+    //! \brief The position of \a value within the admissible values
+    //! \details Constant time if the values are consecutive, as for metric parameters
+    size_t index_of(int value) const;
     //! \brief Whether the parameter should shift to adjacent values instead of hopping between values
     bool is_metric() const;
-    //! \brief Generate a random value, useful for the initial value
-    int random_value() const;
-    //! \brief Randomly get the result from shifting the given \a value
-    int shifted_value_from(int value) const;
+    //! \brief Generate a random value using \a engine, useful for the initial value
+    int random_value(RandomEngine& engine = RandomEngine::thread_engine()) const;
+    //! \brief Randomly get the result from shifting the given \a value, using \a engine
+    int shifted_value_from(int value, RandomEngine& engine = RandomEngine::thread_engine()) const;
 
     bool operator==(ConfigurationSearchParameter const& p) const;
     bool operator<(ConfigurationSearchParameter const& p) const;
@@ -64,6 +68,7 @@ class ConfigurationSearchParameter {
     const ConfigurationPropertyPath _path;
     const bool _is_metric;
     const List<int> _values;
+    const bool _has_consecutive_values;
 };
 
 } // namespace ProNest
@@ -33,8 +33,16 @@
 #ifndef PRONEST_CONFIGURATION_SEARCH_POINT_HPP
 #define PRONEST_CONFIGURATION_SEARCH_POINT_HPP
 
+#include <utility>
+#include <optional>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
 #include "configuration_search_parameter.hpp"
 #include "configuration_search_space.hpp"
+#include "random_engine.hpp"
+#include "work_stealing_pool.hpp"
+#include "configuration_property_interface.hpp"
 #include "configurable.hpp"
 
 namespace ProNest {
@@ -43,43 +51,62 @@ using Helper::List;
 
 using ParameterBindingsMap = Map<ConfigurationPropertyPath,int>;
 
+class ConfigurationSearchPointNeighbours;
+
 class ConfigurationSearchPoint {
     friend class ConfigurationSearchSpace;
   protected:
-    ConfigurationSearchPoint(ConfigurationSearchSpace const& space, ParameterBindingsMap const& bindings);
+    ConfigurationSearchPoint(ConfigurationSearchSpace const& space, List<int> const& coordinates);
   public:
-    ConfigurationSearchPoint(ConfigurationSearchPoint const& p);
+    ConfigurationSearchPoint(ConfigurationSearchPoint const& p) = default;
     ~ConfigurationSearchPoint() = default;
 
     //! \brief The parameter space
     ConfigurationSearchSpace const& space() const;
 
     //! \brief The coordinates in the natural space, according to the space ordering
-    List<int> coordinates() const;
+    //! \details This is the actual storage of the point, indexed by the parameter ordinal in the space
+    List<int> const& coordinates() const;
 
-    //! \brief Generate a point adjacent to this one by shifting one parameter
-    ConfigurationSearchPoint make_adjacent_shifted() const;
+    //! \brief Generate a feasible point adjacent to this one by shifting one parameter, using \a engine
+    //! \details With constraints, adjacent points are drawn without replacement until a feasible one is found
+    ConfigurationSearchPoint make_adjacent_shifted(RandomEngine& engine = RandomEngine::thread_engine()) const;
+    //! \brief The number of points adjacent to this one, i.e., the sum of the shift breadths, regardless of constraints
+    size_t num_adjacent_points() const;
+    //! \brief The adjacent point with the given \a index, lower than num_adjacent_points(), regardless of constraints
+    //! \details Adjacent points are ordered by parameter, then by shifted value.
+    ConfigurationSearchPoint make_adjacent(size_t index) const;
+    //! \brief The lazy range of the feasible points adjacent to this one
+    ConfigurationSearchPointNeighbours neighbours() const;
     //! \brief Generate an \a amount of points by shifting one parameter each from the current point,
     //! then the next point to shift from is a random one from those already generated
     //! \details Guarantees that all points are different. Includes the original point.
-    //! If \a amount is 1, no new point is generated.
-    Set<ConfigurationSearchPoint> make_random_shifted(size_t amount) const;
+    //! If \a amount is 1, no new point is generated. Takes time linear in \a amount and in the dimension,
+    //! apart from the final ordering of the result. With constraints, the points are generated as by
+    //! make_extended_set_by_shifting(), which fails if not enough feasible points can be reached.
+    Set<ConfigurationSearchPoint> make_random_shifted(size_t amount, RandomEngine& engine = RandomEngine::thread_engine()) const;
 
-    ParameterBindingsMap const& bindings() const;
+    //! \brief The coordinates keyed by parameter path
+    //! \details Constructed on demand from the coordinates
+    ParameterBindingsMap bindings() const;
 
     //! \brief The value of the point for the given parameter path \a path
     int value(ConfigurationPropertyPath const& path) const;
+    //! \brief The value of the point for the parameter of ordinal \a idx in the space
+    int value(size_t idx) const;
     //! \brief The index in the space for the parameter identifier \a path
     size_t index(ConfigurationPropertyPath const& path) const;
     //! \brief The parameter corresponding to the identifier \a path
     ConfigurationSearchParameter const& parameter(ConfigurationPropertyPath const& path) const;
 
-    ConfigurationSearchPoint& operator=(ConfigurationSearchPoint const& p);
+    ConfigurationSearchPoint& operator=(ConfigurationSearchPoint const& p) = default;
     //! \brief Equality check is performed under the assumption that we always work with the same parameters,
     //! hence no space check is performed.
     bool operator==(ConfigurationSearchPoint const& p) const;
     //! \brief Ordering is based on point value
     bool operator<(ConfigurationSearchPoint const& p) const;
+    //! \brief The hash of the coordinates, consistent with equality
+    size_t hash() const;
     //! \brief The distance with respect to another point
     //! \details Distance between values for non-metric parameters is either 1 or 0
     unsigned int distance(ConfigurationSearchPoint const& p) const;
@@ -90,33 +117,159 @@ class ConfigurationSearchPoint {
     friend ostream& operator<<(ostream& os, ConfigurationSearchPoint const& point);
   private:
 
-    std::shared_ptr<ConfigurationSearchSpace> _space;
-    ParameterBindingsMap _bindings;
+    ConfigurationSearchSpace _space;
+    List<int> _coordinates;
+};
+
+//! \brief A lazy range over the points adjacent to a centre point, i.e., reachable by shifting a single parameter
+//! \details Metric parameters shift up or down by one, non-metric ones to any other value. Points are constructed on
+//! access, in the order given by ConfigurationSearchPoint::make_adjacent(). If the space has constraints, the indices
+//! of the feasible neighbours are found on construction, and only those neighbours are in the range.
+class ConfigurationSearchPointNeighbours {
+  public:
+    class Iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ConfigurationSearchPoint;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ConfigurationSearchPoint;
+
+        Iterator(ConfigurationSearchPointNeighbours const& neighbours, size_t index);
+
+        ConfigurationSearchPoint operator*() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(Iterator const& other) const;
+        bool operator!=(Iterator const& other) const;
+
+        //! \brief The index of the current point in the range
+        size_t index() const;
+      private:
+        ConfigurationSearchPointNeighbours const* _neighbours;
+        size_t _index;
+    };
+
+    ConfigurationSearchPointNeighbours(ConfigurationSearchPoint const& centre);
+
+    ConfigurationSearchPoint const& centre() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+    size_t size() const;
+    bool empty() const;
 
-    mutable List<unsigned int> _CACHED_SHIFT_BREADTHS;
+    //! \brief The neighbour with the given \a index
+    ConfigurationSearchPoint operator[](size_t index) const;
+
+    //! \brief Evaluate \a f on all the neighbours using up to \a concurrency threads
+    //! \return The results in the order of the neighbours
+    template<class F> List<std::invoke_result_t<F const&,ConfigurationSearchPoint const&>> evaluate(F const& f, size_t concurrency = 1) const {
+        using R = std::invoke_result_t<F const&,ConfigurationSearchPoint const&>;
+        HELPER_PRECONDITION(concurrency > 0);
+        List<std::optional<R>> slots(_size);
+        run_concurrently(_size, concurrency, [&](size_t i) { slots[i].emplace(f((*this)[i])); });
+
+        List<R> result;
+        result.reserve(_size);
+        for (auto& slot : slots) result.push_back(std::move(*slot));
+        return result;
+    }
+
+  private:
+    ConfigurationSearchPoint _centre;
+    //! \brief The adjacent indices of the feasible neighbours, only if the space has constraints
+    List<size_t> _feasible_indices;
+    size_t _size;
 };
 
-//! \brief Generate an \a amount of new points from \a sources, by shifting one parameter each (ideally, see details)
+//! \brief Generate new points from \a sources up to a total \a size, by shifting one parameter each (ideally, see details)
 //! \return The original points plus the shifted ones
 //! \details \a size must be greater or equal than \a sources size but still lower than the maximum number of points
-//! for the space. Shifting points are chosen by rotation, skipping to the next if the generated point is not new-
-//! An effort is made to shift only by 1 with respect to the sources, but if not possible then the generated
-//! points are added to the points used for shifting.
-Set<ConfigurationSearchPoint> make_extended_set_by_shifting(Set<ConfigurationSearchPoint> const& sources, size_t size);
+//! for the space. New points are drawn without replacement among the points adjacent to the sources. If these are
+//! not enough, all of them are taken and the points adjacent to them are drawn, and so on: hence new points are at
+//! the lowest possible number of shifts from the sources, and the time is bounded by the adjacent points visited.
+//! Infeasible points are discarded, and are not shifted from.
+//! Drawing uses up to \a concurrency threads, with streams split from \a engine; the result is reproducible for a
+//! given \a engine state only if using one thread.
+Set<ConfigurationSearchPoint> make_extended_set_by_shifting(Set<ConfigurationSearchPoint> const& sources, size_t size, RandomEngine& engine = RandomEngine::thread_engine(), size_t concurrency = 1);
 
-//! \brief Make a configuration from another configuration \a cfg and a point \a p in the search space
-template<class C> Configuration<C> make_singleton(Configuration<C> const& cfg, ConfigurationSearchPoint const& p) {
-    HELPER_PRECONDITION(not cfg.is_singleton());
-    Configuration<C> result = cfg;
-    for (auto const& param : p.space().parameters()) {
-        auto prop_ptr = result.properties().find(param.path().first());
-        HELPER_ASSERT_MSG(prop_ptr != result.properties().end(), "The ConfigurationSearchPoint parameter '" << param.path() << "' is not in the configuration.");
-        prop_ptr->second->set_single(param.path().subpath(),p.value(param.path()));
+//! \brief A maker of singleton configurations from a configuration \a cfg, for points of a given search space
+//! \details The check that properties not affected by the space are already single is performed once on construction,
+//! and such properties are shared with \a cfg by the results. Making is safe to perform concurrently.
+template<class C> class ConfigurationSingletonMaker {
+  public:
+    ConfigurationSingletonMaker(Configuration<C> const& cfg, ConfigurationSearchSpace const& space) : _cfg(cfg), _space(space) {
+        HELPER_PRECONDITION(not cfg.is_singleton());
+        auto const properties = cfg.properties();
+        for (auto const& param : space.parameters()) {
+            auto const& name = param.path().first();
+            HELPER_ASSERT_MSG(properties.find(name) != properties.end(), "The ConfigurationSearchPoint parameter '" << param.path() << "' is not in the configuration.");
+            _affected_names.insert(name);
+        }
+        for (auto const& p : properties)
+            if (not _affected_names.contains(p.first))
+                HELPER_ASSERT_MSG(_is_single(*p.second),"There are missing parameters in the search point, since the configuration could not be made singleton.");
     }
-    HELPER_ASSERT_MSG(result.is_singleton(),"There are missing parameters in the search point, since the configuration could not be made singleton.");
+
+    //! \brief The singleton configuration for \a point, which must belong to the space
+    Configuration<C> make(ConfigurationSearchPoint const& point) const {
+        HELPER_PRECONDITION(point.space() == _space);
+        Configuration<C> result(_cfg);
+        auto const& coordinates = point.coordinates();
+        for (size_t j=0; j<coordinates.size(); ++j)
+            result.set_single(_space.parameters()[j].path(),coordinates[j]);
+        for (auto const& name : _affected_names)
+            HELPER_ASSERT_MSG(_is_single(std::as_const(result).property_at(ConfigurationPropertyPath(name))),"There are missing parameters in the search point, since the configuration could not be made singleton.");
+        return result;
+    }
+
+  private:
+    static bool _is_single(ConfigurationPropertyInterface const& property) {
+        for (auto const& entry : property.integer_values()) if (entry.second.size() > 1) return false;
+        return true;
+    }
+
+  private:
+    Configuration<C> const _cfg;
+    ConfigurationSearchSpace const _space;
+    Set<String> _affected_names;
+};
+
+//! \brief Make a configuration from another configuration \a cfg for each of the \a points in the search space
+//! \return The configurations in the same order as \a points
+//! \details All points must belong to the same space. The checks on \a cfg are performed once for all points, as
+//! by ConfigurationSingletonMaker. The configurations are made using up to \a concurrency threads.
+template<class C> List<Configuration<C>> make_singletons(Configuration<C> const& cfg, List<ConfigurationSearchPoint> const& points, size_t concurrency = 1) {
+    HELPER_PRECONDITION(concurrency > 0);
+    if (points.empty()) return {};
+    auto const& space = points.front().space();
+    for (auto const& p : points) HELPER_PRECONDITION(p.space() == space);
+    ConfigurationSingletonMaker<C> const maker(cfg, space);
+
+    List<std::optional<Configuration<C>>> slots(points.size());
+    run_concurrently(points.size(), concurrency, [&](size_t i) { slots[i].emplace(maker.make(points[i])); });
+
+    List<Configuration<C>> result;
+    result.reserve(points.size());
+    for (auto& slot : slots) result.push_back(std::move(*slot));
     return result;
 }
 
+//! \brief Make a configuration from \a cfg for each of the \a points in the search space, ordered as the points
+template<class C> List<Configuration<C>> make_singletons(Configuration<C> const& cfg, Set<ConfigurationSearchPoint> const& points, size_t concurrency = 1) {
+    return make_singletons(cfg, List<ConfigurationSearchPoint>(points.begin(), points.end()), concurrency);
+}
+
+//! \brief Make a configuration from another configuration \a cfg and a point \a p in the search space
+template<class C> Configuration<C> make_singleton(Configuration<C> const& cfg, ConfigurationSearchPoint const& p) {
+    return std::move(make_singletons(cfg, List<ConfigurationSearchPoint>({p})).front());
+}
+
 } // namespace ProNest
 
+template<> struct std::hash<ProNest::ConfigurationSearchPoint> {
+    size_t operator()(ProNest::ConfigurationSearchPoint const& point) const noexcept { return point.hash(); }
+};
+
 #endif // PRONEST_CONFIGURATION_SEARCH_POINT_HPP
@@ -0,0 +1,123 @@
+/***************************************************************************
+ *            configuration_search_point_range.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_point_range.hpp
+ *  \brief Class for lazily enumerating the points of a search space.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_POINT_RANGE_HPP
+#define PRONEST_CONFIGURATION_SEARCH_POINT_RANGE_HPP
+
+#include <cstdint>
+#include <iterator>
+#include "helper/container.hpp"
+#include "configuration_search_space.hpp"
+#include "configuration_search_point.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+
+//! \brief The order in which the points of a space are enumerated
+//! \details In LEXICOGRAPHIC order the rank of a point is its index in the space encoding.
+//! In GRAY order (reflected mixed-radix Gray code) consecutive points differ by one position in the values
+//! of exactly one parameter, hence by one shift for metric parameters.
+enum class ConfigurationSearchPointOrdering { LEXICOGRAPHIC, GRAY };
+
+//! \brief A lazy range over the points of a space having rank in [begin,end)
+//! \details Points are constructed on dereference, hence the whole set is never materialised. If the space has
+//! constraints, iteration skips the infeasible points, while sizes and ranks still count all points.
+class ConfigurationSearchPointRange {
+  public:
+    class Iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ConfigurationSearchPoint;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ConfigurationSearchPoint;
+
+        Iterator(ConfigurationSearchPointRange const& range, uint64_t rank);
+
+        ConfigurationSearchPoint operator*() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(Iterator const& other) const;
+        bool operator!=(Iterator const& other) const;
+
+        //! \brief The rank of the current point in the ordering
+        uint64_t rank() const;
+      private:
+        //! \brief Move to the next rank, feasible or not
+        void _step();
+        //! \brief Move to the first feasible rank from the current one, or to the end
+        void _skip_infeasible();
+      private:
+        ConfigurationSearchPointRange const* _range;
+        uint64_t _rank;
+        //! \brief The mixed-radix digits of the rank, most significant first
+        List<size_t> _digits;
+    };
+
+    //! \brief Construct the range over all the points of \a space
+    ConfigurationSearchPointRange(ConfigurationSearchSpace const& space, ConfigurationSearchPointOrdering ordering = ConfigurationSearchPointOrdering::LEXICOGRAPHIC);
+    //! \brief Construct the range over the points of \a space having rank in [\a begin, \a end)
+    ConfigurationSearchPointRange(ConfigurationSearchSpace const& space, ConfigurationSearchPointOrdering ordering, uint64_t begin, uint64_t end);
+
+    ConfigurationSearchSpace const& space() const;
+    ConfigurationSearchPointOrdering ordering() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+    //! \brief The number of points in the range
+    uint64_t size() const;
+    bool empty() const;
+
+    //! \brief The point with the given \a rank in the ordering
+    ConfigurationSearchPoint point_at(uint64_t rank) const;
+
+    //! \brief The chunk \a i out of \a n disjoint contiguous chunks covering the range
+    //! \details Chunk sizes differ by at most one, with the larger chunks first
+    ConfigurationSearchPointRange chunk(size_t i, size_t n) const;
+    //! \brief Split the range into \a n disjoint contiguous chunks
+    List<ConfigurationSearchPointRange> partition(size_t n) const;
+
+  private:
+    List<size_t> _digits_of(uint64_t rank) const;
+    ConfigurationSearchPoint _point_from(List<size_t> const& digits) const;
+
+  private:
+    ConfigurationSearchSpace _space;
+    ConfigurationSearchPointOrdering _ordering;
+    uint64_t _begin;
+    uint64_t _end;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_POINT_RANGE_HPP
@@ -0,0 +1,83 @@
+/***************************************************************************
+ *            configuration_search_point_set.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_point_set.hpp
+ *  \brief Class for a set of points with both hashed membership and random access.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_POINT_SET_HPP
+#define PRONEST_CONFIGURATION_SEARCH_POINT_SET_HPP
+
+#include <unordered_map>
+#include "helper/container.hpp"
+#include "configuration_search_point.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+using Helper::Set;
+
+//! \brief A set of distinct points, stored in insertion order with a hash index
+//! \details Membership and insertion take time linear in the dimension only, and points can be accessed by position,
+//! which allows to pick a random point in constant time. Points are assumed to belong to the same space.
+class ConfigurationSearchPointSet {
+  public:
+    using const_iterator = List<ConfigurationSearchPoint>::const_iterator;
+
+    ConfigurationSearchPointSet() = default;
+    ConfigurationSearchPointSet(Set<ConfigurationSearchPoint> const& points);
+
+    //! \brief Add the \a point if not present
+    //! \return Whether the point has been added
+    bool insert(ConfigurationSearchPoint const& point);
+    //! \brief Whether the \a point is present
+    bool contains(ConfigurationSearchPoint const& point) const;
+
+    size_t size() const;
+    bool empty() const;
+
+    //! \brief The point at \a position, in order of insertion
+    ConfigurationSearchPoint const& operator[](size_t position) const;
+    //! \brief The points in order of insertion
+    List<ConfigurationSearchPoint> const& points() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    //! \brief Convert into an ordered set
+    Set<ConfigurationSearchPoint> to_set() const;
+
+  private:
+    List<ConfigurationSearchPoint> _points;
+    //! \brief The positions of the points, keyed by their hash
+    std::unordered_multimap<size_t,size_t> _positions;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_POINT_SET_HPP
@@ -0,0 +1,91 @@
+/***************************************************************************
+ *            configuration_search_population.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_population.hpp
+ *  \brief Class for distances and diversity metrics over a population of points.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_POPULATION_HPP
+#define PRONEST_CONFIGURATION_SEARCH_POPULATION_HPP
+
+#include <cstdint>
+#include "helper/container.hpp"
+#include "configuration_search_point.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+
+//! \brief A population of points of the same space, for computing distances and diversity metrics in batch
+//! \details Coordinates are stored by parameter in contiguous arrays, and the distances from a point are computed
+//! for all the other points at once, parameter by parameter: the loops over the population have no branches and are
+//! vectorised by the compiler. Distances are as in ConfigurationSearchPoint::distance, i.e., the absolute difference
+//! of values for metric parameters and 0 or 1 for non-metric ones.
+class ConfigurationSearchPopulation {
+  public:
+    ConfigurationSearchPopulation(List<ConfigurationSearchPoint> const& points);
+
+    //! \brief The number of points
+    size_t size() const;
+    //! \brief The point at \a index
+    ConfigurationSearchPoint point(size_t index) const;
+
+    //! \brief The distances of all points from the point at \a index
+    List<unsigned int> distances_from(size_t index) const;
+    //! \brief The full distance matrix, stored by row
+    List<unsigned int> distance_matrix() const;
+    //! \brief For each point, the distances of its \a k nearest other points in increasing order
+    List<List<unsigned int>> nearest_distances(size_t k) const;
+
+    //! \brief The largest distance possible between two points of the space
+    unsigned int maximum_distance() const;
+    //! \brief The mean distance over all pairs of distinct points, zero if less than two points
+    double mean_distance() const;
+    //! \brief The mean distance normalised by the maximum distance, in [0,1]
+    //! \details A low value suggests that the population has collapsed, e.g., to restart a search
+    double diversity() const;
+    //! \brief For each point, the mean distance of its \a k nearest other points
+    //! \details Lower values identify points in crowded regions of the population
+    List<double> crowding(size_t k) const;
+
+  private:
+    //! \brief Accumulate into \a result the distances of the points from \a first onwards from the point at \a index
+    void _accumulate_distances(size_t index, size_t first, unsigned int* result) const;
+
+  private:
+    ConfigurationSearchSpace _space;
+    size_t _size;
+    //! \brief The coordinates by parameter, each array with the values for all the points
+    List<List<int>> _columns;
+    //! \brief Whether each parameter is metric
+    List<bool> _is_metric;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_POPULATION_HPP
@@ -0,0 +1,122 @@
+/***************************************************************************
+ *            include/configuration_search_process_pool.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_process_pool.hpp
+ *  \brief Classes for evaluating costs in a pool of worker processes.
+ *  \details Available on POSIX systems only, since workers are forked and connected by Unix domain sockets.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_PROCESS_POOL_HPP
+#define PRONEST_CONFIGURATION_SEARCH_PROCESS_POOL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include "helper/container.hpp"
+#include "helper/string.hpp"
+#include "configuration_search_point.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+using Helper::String;
+
+//! \brief Encode the coordinates of \a point as zigzag variable-length integers, taking one byte for small values
+List<uint8_t> encode_point(ConfigurationSearchPoint const& point);
+//! \brief Decode a point of \a space from \a bytes produced by encode_point()
+ConfigurationSearchPoint decode_point(ConfigurationSearchSpace const& space, List<uint8_t> const& bytes);
+
+//! \brief The outcome of evaluating a point in a worker process
+struct ConfigurationSearchProcessEvaluation {
+    ConfigurationSearchPoint point;
+    //! \brief The cost, missing if the evaluation failed
+    std::optional<double> cost;
+    //! \brief The message of the exception thrown by the cost, or a description of the crash of the worker
+    String error;
+    //! \brief Whether the worker process terminated during the evaluation
+    bool is_crashed;
+    std::chrono::nanoseconds duration;
+};
+
+//! \brief A persistent pool of worker processes evaluating the costs of points
+//! \details The workers are forked on construction and each is connected to the coordinator by a Unix domain socket.
+//! The coordinator sends each worker a point at a time, compactly encoded, and the worker evaluates it and sends
+//! back the cost. Hence the cost runs isolated from the coordinator and from the other evaluations, with no process
+//! startup per evaluation. A worker terminating during an evaluation, e.g., by a crash on a poisoned configuration,
+//! is replaced by a new one and the evaluation is reported as crashed, while an exception thrown by the cost is
+//! reported as an error with the worker kept. Workers still running a cost a grace period after the pool is
+//! destroyed are terminated by SIGTERM and then SIGKILL. Since workers are forked, also when replaced, the pool should be
+//! created and used when no other thread of the coordinator holds locks needed by the cost.
+class ConfigurationSearchProcessPool {
+  public:
+    using Cost = std::function<double(ConfigurationSearchPoint const&)>;
+    using Callback = std::function<void(ConfigurationSearchProcessEvaluation const&)>;
+
+    //! \brief Construct with \a num_workers processes evaluating \a cost for points of \a space
+    ConfigurationSearchProcessPool(ConfigurationSearchSpace const& space, Cost const& cost, size_t num_workers);
+
+    //! \brief Construct with \a num_workers processes evaluating the \a cost of singleton configurations of \a cfg
+    //! \details The singleton configurations are made by the workers from the points received
+    template<class C, class F> ConfigurationSearchProcessPool(Configuration<C> const& cfg, F const& cost, size_t num_workers)
+        : ConfigurationSearchProcessPool(cfg.search_space(), [maker = ConfigurationSingletonMaker<C>(cfg, cfg.search_space()), cost](ConfigurationSearchPoint const& p) {
+            return static_cast<double>(cost(maker.make(p))); }, num_workers) { }
+
+    ~ConfigurationSearchProcessPool();
+
+    ConfigurationSearchProcessPool(ConfigurationSearchProcessPool const&) = delete;
+    ConfigurationSearchProcessPool& operator=(ConfigurationSearchProcessPool const&) = delete;
+
+    size_t num_workers() const;
+    //! \brief The number of workers replaced after terminating
+    size_t num_restarts() const;
+
+    //! \brief Evaluate \a points on the workers, calling \a on_result on each evaluation as it completes
+    //! \details The evaluations are returned in the order of the points. If \a cancellation is cancelled, the
+    //! evaluations in progress are completed and the remaining points are not evaluated, hence not returned.
+    List<ConfigurationSearchProcessEvaluation> evaluate(List<ConfigurationSearchPoint> const& points, Callback const& on_result = nullptr,
+                                                        CancellationToken const& cancellation = CancellationToken());
+
+  private:
+    void _spawn(size_t worker);
+    //! \brief Shut down and close the socket of \a worker
+    void _close(size_t worker);
+    //! \brief Close the socket of \a worker and wait for it to exit, killing it after a grace period
+    void _stop(size_t worker);
+
+    ConfigurationSearchSpace _space;
+    Cost _cost;
+    List<int> _pids;
+    List<int> _sockets;
+    size_t _num_restarts;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_PROCESS_POOL_HPP
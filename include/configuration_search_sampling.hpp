@@ -0,0 +1,65 @@
+/***************************************************************************
+ *            configuration_search_sampling.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_sampling.hpp
+ *  \brief Functions for sampling well-spread points of a search space.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_SAMPLING_HPP
+#define PRONEST_CONFIGURATION_SEARCH_SAMPLING_HPP
+
+#include "helper/container.hpp"
+#include "configuration_search_space.hpp"
+#include "configuration_search_point.hpp"
+#include "random_engine.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+
+//! \brief The design used for sampling points of a space
+//! \details UNIFORM draws each point independently, as initial_point() does.
+//! LATIN_HYPERCUBE stratifies each parameter, so that its values are covered as evenly as possible.
+//! HALTON and SOBOL use low-discrepancy sequences, randomised by a shift, which cover the space evenly at any amount;
+//! SOBOL supports up to SOBOL_MAXIMUM_DIMENSION parameters.
+enum class ConfigurationSearchSampling { UNIFORM, LATIN_HYPERCUBE, HALTON, SOBOL };
+
+//! \brief The largest dimension supported by SOBOL sampling
+static constexpr size_t SOBOL_MAXIMUM_DIMENSION = 21;
+
+//! \brief Sample an \a amount of distinct points from \a space using the given \a sampling, with random choices from \a engine
+//! \details The design produces a coordinate in [0,1) for each parameter, which is mapped onto the position within
+//! the values of the parameter. For metric parameters the values are taken in order, so that the spread in the design
+//! is a spread in distance; for non-metric parameters the values are randomly permuted, since their order is not
+//! meaningful, and only their even coverage is preserved. Duplicate and infeasible points are discarded, and if the
+//! design does not yield enough distinct points the remaining ones are obtained by shifting.
+List<ConfigurationSearchPoint> make_sampled_points(ConfigurationSearchSpace const& space, size_t amount, ConfigurationSearchSampling sampling, RandomEngine& engine = RandomEngine::thread_engine());
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_SAMPLING_HPP
@@ -0,0 +1,138 @@
+/***************************************************************************
+ *            configuration_search_scheduler.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_scheduler.hpp
+ *  \brief Classes for scheduling evaluations of search points at increasing budgets.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_SCHEDULER_HPP
+#define PRONEST_CONFIGURATION_SEARCH_SCHEDULER_HPP
+
+#include "configuration_search_evaluator.hpp"
+#include "configuration_search_sampling.hpp"
+
+namespace ProNest {
+
+//! \brief The evaluations of a rung of successive halving, all at the same budget
+struct ConfigurationSearchStage {
+    //! \brief The Hyperband bracket, where bracket s starts s rungs below the maximum budget
+    size_t bracket;
+    //! \brief The rung within the bracket, starting from zero
+    size_t rung;
+    double budget;
+    //! \brief The evaluations by increasing cost
+    List<ConfigurationSearchEvaluation> evaluations;
+
+    //! \brief The best evaluation at this stage
+    ConfigurationSearchEvaluation const& incumbent() const { HELPER_PRECONDITION(not evaluations.empty()); return evaluations.front(); }
+};
+
+//! \brief A scheduler of evaluations at increasing fidelity, by successive halving and Hyperband
+//! \details Budgets range from a minimum to a maximum budget, growing by the reduction factor eta between rungs.
+//! Successive halving evaluates points at the budget of the first rung, then promotes the best 1/eta of them to the
+//! next rung, until the maximum budget. Hyperband runs successive halving over brackets, from the most exploratory
+//! (many points, starting at the minimum budget) to the most conservative (few points, all at the maximum budget).
+//! The cost function receives the configuration and the budget, and lower costs are better.
+class ConfigurationSearchScheduler {
+  public:
+    ConfigurationSearchScheduler(double minimum_budget, double maximum_budget, size_t reduction_factor = 3);
+
+    double minimum_budget() const;
+    double maximum_budget() const;
+    size_t reduction_factor() const;
+
+    //! \brief The number of brackets, i.e., one more than the number of rungs from the minimum to the maximum budget
+    size_t num_brackets() const;
+    //! \brief The number of points to start the given \a bracket with for Hyperband
+    size_t bracket_size(size_t bracket) const;
+    //! \brief The budget for the given \a rung of the given \a bracket
+    double rung_budget(size_t bracket, size_t rung) const;
+    //! \brief The number of points promoted from a rung with \a num_points points, at least one
+    size_t num_promoted(size_t num_points) const;
+
+    //! \brief Run successive halving on the \a points of \a bracket, evaluating \a cost on the configurations from \a cfg
+    //! \return The stages, one for each rung evaluated
+    //! \details Stops early if \a cancellation is cancelled, with the last stage holding the evaluations completed.
+    //! The \a evaluator must have no cache, since cached costs are keyed by point only while the same points are
+    //! evaluated again at higher budgets.
+    template<class C, class F> List<ConfigurationSearchStage> successive_halving(ConfigurationSearchEvaluator& evaluator, Configuration<C> const& cfg,
+                                                                                List<ConfigurationSearchPoint> const& points, F const& cost, size_t bracket,
+                                                                                CancellationToken const& cancellation = CancellationToken()) const {
+        HELPER_PRECONDITION(bracket < num_brackets());
+        HELPER_PRECONDITION(evaluator.cache() == nullptr);
+        List<ConfigurationSearchStage> result;
+        List<ConfigurationSearchPoint> current = points;
+        for (size_t rung=0; rung<=bracket and not current.empty() and not cancellation.is_cancelled(); ++rung) {
+            double const budget = rung_budget(bracket, rung);
+            auto evaluations = evaluator.evaluate(cfg, current, [&cost,budget](Configuration<C> const& c) { return cost(c, budget); }, cancellation);
+            if (evaluations.empty()) break;
+            current.clear();
+            for (size_t i=0; i<num_promoted(evaluations.size()); ++i) current.push_back(evaluations[i].point);
+            result.push_back({bracket, rung, budget, std::move(evaluations)});
+        }
+        return result;
+    }
+
+    //! \brief Run successive halving on the \a points, from the minimum to the maximum budget
+    template<class C, class F> List<ConfigurationSearchStage> successive_halving(ConfigurationSearchEvaluator& evaluator, Configuration<C> const& cfg,
+                                                                                List<ConfigurationSearchPoint> const& points, F const& cost,
+                                                                                CancellationToken const& cancellation = CancellationToken()) const {
+        return successive_halving(evaluator, cfg, points, cost, num_brackets()-1, cancellation);
+    }
+
+    //! \brief Run Hyperband on the search space of \a cfg, with the points of each bracket drawn by \a sampling
+    //! \return The stages of all the brackets, in order of execution
+    //! \details The number of points of a bracket is capped to the points of the space. The \a evaluator must have no cache.
+    template<class C, class F> List<ConfigurationSearchStage> hyperband(ConfigurationSearchEvaluator& evaluator, Configuration<C> const& cfg, F const& cost,
+                                                                       ConfigurationSearchSampling sampling = ConfigurationSearchSampling::LATIN_HYPERCUBE,
+                                                                       RandomEngine& engine = RandomEngine::thread_engine(),
+                                                                       CancellationToken const& cancellation = CancellationToken()) const {
+        HELPER_PRECONDITION(evaluator.cache() == nullptr);
+        auto const space = cfg.search_space();
+        List<ConfigurationSearchStage> result;
+        for (size_t bracket=num_brackets(); bracket>0 and not cancellation.is_cancelled(); --bracket) {
+            auto points = make_sampled_points(space, std::min(bracket_size(bracket-1), space.total_points()), sampling, engine);
+            for (auto& stage : successive_halving(evaluator, cfg, points, cost, bracket-1, cancellation))
+                result.push_back(std::move(stage));
+        }
+        return result;
+    }
+
+  private:
+    double const _minimum_budget;
+    double const _maximum_budget;
+    size_t const _reduction_factor;
+    size_t _num_brackets;
+};
+
+//! \brief The best evaluation at the maximum budget among the \a stages, which must include one at that budget
+ConfigurationSearchEvaluation const& best_at_maximum_budget(List<ConfigurationSearchStage> const& stages);
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_SCHEDULER_HPP
@@ -33,8 +33,12 @@
 #ifndef PRONEST_CONFIGURATION_SEARCH_SPACE_HPP
 #define PRONEST_CONFIGURATION_SEARCH_SPACE_HPP
 
+#include <memory>
+#include <cstdint>
 #include "helper/container.hpp"
 #include "configuration_search_parameter.hpp"
+#include "configuration_search_constraint.hpp"
+#include "random_engine.hpp"
 
 namespace ProNest {
 
@@ -48,17 +52,40 @@ template<class R> class Variable;
 
 using ParameterBindingsMap = Map<ConfigurationPropertyPath,int>;
 
+//! \brief A space of search parameters
+//! \details The space is immutable and its content is shared between copies, hence copying a space (and
+//! consequently a point, which holds its space) does not copy the parameters.
+//! Constraints between parameters restrict the points that are feasible: random points, shifted points and the
+//! enumeration of points only yield feasible ones, while points made explicitly are not checked.
 class ConfigurationSearchSpace {
+    struct Data;
   public:
-    ConfigurationSearchSpace(Set<ConfigurationSearchParameter> const& parameters);
+    ConfigurationSearchSpace(Set<ConfigurationSearchParameter> const& parameters, List<ConfigurationSearchConstraint> const& constraints = {});
 
     ConfigurationSearchPoint make_point(ParameterBindingsMap const& bindings) const;
-    ConfigurationSearchPoint initial_point() const;
+    //! \brief Make a point from the \a coordinates, ordered as the parameters of the space
+    ConfigurationSearchPoint make_point(List<int> const& coordinates) const;
+    //! \brief Make a feasible point with random coordinates drawn from \a engine
+    //! \details With constraints, the values are drawn parameter by parameter among those satisfying the constraints
+    //! that can be checked on the values already drawn, backtracking only if no value is left.
+    ConfigurationSearchPoint initial_point(RandomEngine& engine = RandomEngine::thread_engine()) const;
 
     List<ConfigurationSearchParameter> const& parameters() const;
+    List<ConfigurationSearchConstraint> const& constraints() const;
 
-    //! \brief The total number of points identified by the space
+    //! \brief Whether the \a coordinates, ordered as the parameters of the space, satisfy all the constraints
+    bool is_feasible(List<int> const& coordinates) const;
+    //! \brief Whether the \a point satisfies all the constraints
+    bool is_feasible(ConfigurationSearchPoint const& point) const;
+
+    //! \brief The total number of points identified by the space, feasible or not, saturated to the maximum size_t value
     size_t total_points() const;
+    //! \brief The index of \a point in the mixed-radix encoding of the space
+    //! \details The first parameter is the most significant digit, with each digit being the position of the
+    //! value within the parameter values: for ascending values, the index order is the same as the point order.
+    uint64_t index_of(ConfigurationSearchPoint const& point) const;
+    //! \brief The point for the given \a index in the mixed-radix encoding of the space, inverse of index_of
+    ConfigurationSearchPoint point_at(uint64_t index) const;
     //! \brief The number of parameters in the space
     size_t dimension() const;
     //! \brief The index of the given parameter in the ordered space
@@ -70,10 +97,13 @@ class ConfigurationSearchSpace {
 
     ConfigurationSearchSpace* clone() const;
 
+    //! \brief Equality holds if the parameters have the same paths, in the same order, and the constraints are the same
+    bool operator==(ConfigurationSearchSpace const& other) const;
+
     friend ostream& operator<<(ostream& os, ConfigurationSearchSpace const& space);
 
   private:
-    List<ConfigurationSearchParameter> _parameters;
+    std::shared_ptr<const Data> _data;
 };
 
 } // namespace ProNest
@@ -0,0 +1,113 @@
+/***************************************************************************
+ *            configuration_search_surrogate.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_surrogate.hpp
+ *  \brief Classes for search guided by a surrogate model of the cost.
+ */
+
+#ifndef PRONEST_CONFIGURATION_SEARCH_SURROGATE_HPP
+#define PRONEST_CONFIGURATION_SEARCH_SURROGATE_HPP
+
+#include <functional>
+#include "configuration_search_forest.hpp"
+#include "configuration_search_evaluator.hpp"
+#include "configuration_search_ask_tell.hpp"
+
+namespace ProNest {
+
+//! \brief The expected improvement over \a best_cost of a cost distributed normally as by \a prediction
+double expected_improvement(ConfigurationSearchPrediction const& prediction, double best_cost);
+
+//! \brief The outcome of a surrogate-guided search
+struct ConfigurationSearchSurrogateResult {
+    ConfigurationSearchPoint best;
+    double best_cost;
+    //! \brief All the evaluations, batch after batch and by increasing cost within a batch
+    List<ConfigurationSearchEvaluation> evaluations;
+};
+
+//! \brief A search proposing batches of points by the expected improvement predicted by a random forest
+//! \details An initial design is evaluated first, then at each iteration the forest is refitted on all the costs
+//! evaluated so far. Candidates are random points of the space and the neighbours of the best points evaluated, and
+//! the batch takes those of highest expected improvement, except for a fraction drawn among the other candidates
+//! to keep exploring. The points of a batch are evaluated in parallel by a ConfigurationSearchEvaluator, and no point
+//! is evaluated twice.
+class ConfigurationSearchSurrogateOptimiser {
+  public:
+    using Cost = std::function<double(ConfigurationSearchPoint const&)>;
+
+    ConfigurationSearchSurrogateOptimiser(size_t num_initial_points, size_t batch_size, size_t num_batches);
+
+    //! \brief Set the number of trees of the forest
+    void set_num_trees(size_t num_trees);
+    //! \brief Set the number of random points among the candidates of each batch
+    void set_num_random_candidates(size_t num_candidates);
+    //! \brief Set the fraction of each batch drawn at random among the candidates
+    void set_random_fraction(double fraction);
+    //! \brief Set the number of costs evaluated at the same time, also used for fitting the forest
+    void set_concurrency(size_t concurrency);
+    //! \brief Set a \a cache for the costs, to be used with only one cost function
+    void set_cache(std::shared_ptr<ConfigurationSearchEvaluationCache> cache);
+
+    //! \brief Search points of \a space minimising \a cost, with random choices from \a engine
+    //! \details Stops when no point is left. The initial design is always evaluated in full; if \a cancellation is
+    //! cancelled, the batch being evaluated is cut short, keeping the costs already evaluated.
+    ConfigurationSearchSurrogateResult optimise(ConfigurationSearchSpace const& space, Cost const& cost,
+                                                RandomEngine& engine = RandomEngine::thread_engine(),
+                                                CancellationToken const& cancellation = CancellationToken()) const;
+
+    //! \brief Search points of the search space of \a cfg, minimising the \a cost of their singleton configurations
+    template<class C, class F> ConfigurationSearchSurrogateResult optimise(Configuration<C> const& cfg, F const& cost,
+                                                                          RandomEngine& engine = RandomEngine::thread_engine(),
+                                                                          CancellationToken const& cancellation = CancellationToken()) const {
+        auto const space = cfg.search_space();
+        ConfigurationSingletonMaker<C> const maker(cfg, space);
+        return optimise(space, [&](ConfigurationSearchPoint const& p) { return static_cast<double>(cost(maker.make(p))); }, engine, cancellation);
+    }
+
+    //! \brief A version of the search over \a space asking for up to \a budget points
+    //! \details The initial design is asked first, then the points are proposed by expected improvement for any amount
+    //! asked, with the forest refitted on the costs told since the last proposal. No point is proposed before any cost
+    //! of the initial design has been told. The batch size, the number of batches and the concurrency are not used.
+    std::shared_ptr<ConfigurationSearchAskTellOptimiser> make_ask_tell(ConfigurationSearchSpace const& space, size_t budget,
+                                                                       RandomEngine& engine = RandomEngine::thread_engine()) const;
+
+  private:
+    size_t _num_initial_points;
+    size_t _batch_size;
+    size_t _num_batches;
+    size_t _num_trees;
+    size_t _num_random_candidates;
+    double _random_fraction;
+    size_t _concurrency;
+    std::shared_ptr<ConfigurationSearchEvaluationCache> _cache;
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_CONFIGURATION_SEARCH_SURROGATE_HPP
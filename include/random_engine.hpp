@@ -0,0 +1,88 @@
+/***************************************************************************
+ *            random_engine.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file random_engine.hpp
+ *  \brief Class for seedable random number generation in searches.
+ */
+
+#ifndef PRONEST_RANDOM_ENGINE_HPP
+#define PRONEST_RANDOM_ENGINE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include "helper/macros.hpp"
+
+namespace ProNest {
+
+//! \brief A seedable pseudo-random engine, supporting independent streams for parallel workers
+//! \details Based on xoshiro256**, with the state initialised by SplitMix64 from the seed and the stream index.
+//! It satisfies the UniformRandomBitGenerator requirements, and draws bounded integers without constructing
+//! distribution objects. Each thread holds its own engine, seeded non-deterministically unless reassigned.
+class RandomEngine {
+  public:
+    using result_type = uint64_t;
+
+    //! \brief Construct from a \a seed and the index of the \a stream
+    //! \details Engines with the same seed and different streams produce independent sequences
+    explicit RandomEngine(uint64_t seed, uint64_t stream = 0);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    //! \brief The next value of the sequence
+    result_type operator()();
+
+    //! \brief A uniformly distributed integer between \a lower and \a upper, both included
+    template<class T> T uniform(T lower, T upper) {
+        HELPER_PRECONDITION(lower <= upper);
+        return static_cast<T>(static_cast<uint64_t>(lower) + _bounded(static_cast<uint64_t>(upper) - static_cast<uint64_t>(lower) + 1));
+    }
+
+    //! \brief A uniformly distributed real number in [0,1)
+    double canonical();
+
+    //! \brief A new engine for an independent stream, whose seed is drawn from this engine
+    //! \details Splitting is deterministic, hence a seeded engine can supply reproducible streams to workers
+    RandomEngine split();
+
+    //! \brief The engine of the current thread
+    //! \details Used by the search functions when no engine is supplied; assign to it to seed the current thread
+    static RandomEngine& thread_engine();
+
+  private:
+    //! \brief A uniformly distributed value in [0,range), with a zero \a range meaning the full range
+    uint64_t _bounded(uint64_t range);
+
+  private:
+    uint64_t _state[4];
+};
+
+} // namespace ProNest
+
+#endif // PRONEST_RANDOM_ENGINE_HPP
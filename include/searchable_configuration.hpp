@@ -34,46 +34,71 @@
 #define PRONEST_SEARCHABLE_CONFIGURATION_HPP
 
 #include <ostream>
+#include <memory>
 #include <type_traits>
 #include "helper/macros.hpp"
 #include "configuration_interface.hpp"
 #include "configuration_property_interface.hpp"
 #include "configuration_property_path.hpp"
+#include "configuration_search_constraint.hpp"
 
 namespace ProNest {
 
 class ConfigurationSearchSpace;
+template<class P> class ConfigurationPropertyHandle;
 
 //! \brief Extension of ConfigurationInterface to deal with search in the properties space
+//! \details Properties are copy-on-write: copies of a configuration share the property objects, and a property
+//! is cloned only when modified through a configuration that does not own it exclusively.
+//! The search space and the integer values are memoised against the version of the properties, and recomputed
+//! only for the properties that changed. Constraints declared with add_constraint are part of the search space.
 class SearchableConfiguration : public ConfigurationInterface {
   public:
-    SearchableConfiguration() = default;
+    SearchableConfiguration();
     SearchableConfiguration(SearchableConfiguration const& c);
+    SearchableConfiguration(SearchableConfiguration&& c);
     SearchableConfiguration& operator=(SearchableConfiguration const& c);
-    virtual ~SearchableConfiguration() = default;
+    SearchableConfiguration& operator=(SearchableConfiguration&& c);
+    virtual ~SearchableConfiguration();
 
     //! \brief Construct a search space from the current configuration
+    //! \details The constraints on paths that are single-valued are bound to their values; a constraint whose paths are
+    //! all single-valued must be satisfied.
     ConfigurationSearchSpace search_space() const;
 
+    //! \brief The integer values of all properties, with paths starting from the configuration
+    Map<ConfigurationPropertyPath,List<int>> integer_values() const;
+
     //! \brief If the configuration is made of single values
     bool is_singleton() const;
 
-    Map<String,std::shared_ptr<ConfigurationPropertyInterface>>& properties();
-    Map<String,std::shared_ptr<ConfigurationPropertyInterface>> const& properties() const;
+    //! \brief The version of the configuration, i.e., the greatest version of its properties
+    //! \details Constant time if no property has been modified anywhere since the last call.
+    size_t version() const;
+
+    //! \brief The properties by name, for reading only
+    //! \details The properties are shared with the configuration but can't be modified through the result, so that
+    //! they are never changed behind the copies sharing them. Properties are modified through property_at or at, added
+    //! with add_property and replaced with replace_property.
+    Map<String,std::shared_ptr<const ConfigurationPropertyInterface>> properties() const;
+
+    //! \brief The property at the given \a path, for reading only
+    ConfigurationPropertyInterface const& property_at(ConfigurationPropertyPath const& path) const;
+    //! \brief The property at the given \a path for modification, detaching any shared property along the path
+    ConfigurationPropertyInterface& property_at(ConfigurationPropertyPath const& path);
+
+    //! \brief Set the property at the given \a path to the single \a integer_value
+    void set_single(ConfigurationPropertyPath const& path, int integer_value);
 
     //! \brief Accessors for get and set of a property identified by a path \a path with type \a P
     //! \details Used in practice to get/set properties for verification
     template<class P> P& at(ConfigurationPropertyPath const& path) {
-        auto prop_ptr = _properties.find(path.first());
-        HELPER_ASSERT_MSG(prop_ptr != _properties.end(),"The property '" << path.first() << "' was not found in the configuration.");
-        auto p_ptr = dynamic_cast<P*>(prop_ptr->second->at(path.subpath()));
+        auto p_ptr = dynamic_cast<P*>(&property_at(path));
         HELPER_ASSERT_MSG(p_ptr != nullptr, "Invalid property cast, check the property class with respect to the configuration created.")
         return *p_ptr;
     }
     template<class P> P const& at(ConfigurationPropertyPath const& path) const {
-        auto prop_ptr = _properties.find(path.first());
-        HELPER_ASSERT_MSG(prop_ptr != _properties.end(),"The property '" << path.first() << "' was not found in the configuration.");
-        auto p_ptr = dynamic_cast<P*>(prop_ptr->second->at(path.subpath()));
+        auto p_ptr = dynamic_cast<P const*>(&property_at(path));
         HELPER_ASSERT_MSG(p_ptr != nullptr, "Invalid property cast, check the property class with respect to the configuration created.")
         return *p_ptr;
     }
@@ -84,13 +109,52 @@ class SearchableConfiguration : public ConfigurationInterface {
     template<class P> P const& at(String const& identifier) const {
         return at<P>(ConfigurationPropertyPath(identifier));
     }
+    //! \brief Accessors using a \a handle resolved in advance, with no lookup by name
+    template<class P> P& at(ConfigurationPropertyHandle<P> const& handle) {
+        return handle.get(*this);
+    }
+    template<class P> P const& at(ConfigurationPropertyHandle<P> const& handle) const {
+        return handle.get(*this);
+    }
 
     //! \brief Add a property to the configuration
     void add_property(String const& name, ConfigurationPropertyInterface const& property);
+    //! \brief Replace the existing property with the given \a name by a copy of \a property
+    //! \details The handles resolved on the configuration can't be used on it anymore.
+    void replace_property(String const& name, ConfigurationPropertyInterface const& property);
+
+    //! \brief Add a constraint between properties, with paths starting from the configuration
+    //! \details The paths must identify properties with integer values, though not necessarily with more than one value.
+    void add_constraint(ConfigurationSearchConstraint const& constraint);
+    //! \brief The constraints added to the configuration
+    List<ConfigurationSearchConstraint> const& constraints() const;
 
     ostream& _write(ostream& os) const override;
   private:
+    template<class P> friend class ConfigurationPropertyHandle;
+    //! \brief Update the properties by ordinal, after the property names changed
+    void _update_ordered_properties();
+    //! \brief The ordinal of the property with the given \a name, in the order of names
+    size_t _ordinal(String const& name) const;
+    //! \brief The property with the given \a name, cloned first if shared
+    std::shared_ptr<ConfigurationPropertyInterface> const& _detached_property(String const& name);
+    //! \brief The property with the given \a ordinal, cloned first if shared
+    std::shared_ptr<ConfigurationPropertyInterface> const& _detached_property(size_t ordinal);
+    //! \brief The version, assuming the cache is locked
+    size_t _locked_version() const;
+    //! \brief Recompute the cached content for the properties that changed, assuming the cache is locked
+    void _locked_refresh() const;
+  private:
+    struct Cache;
     Map<String,std::shared_ptr<ConfigurationPropertyInterface>> _properties;
+    List<ConfigurationSearchConstraint> _constraints;
+    //! \brief The entries of _properties by ordinal
+    List<std::shared_ptr<ConfigurationPropertyInterface>*> _ordered_properties;
+    //! \brief The identity of the structure of the properties, shared by copies and renewed when a property is added
+    //! or replaced
+    size_t _schema;
+    size_t _structure_version;
+    std::unique_ptr<Cache> _cache;
 };
 
 } // namespace ProNest
@@ -0,0 +1,117 @@
+/***************************************************************************
+ *            work_stealing_pool.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file work_stealing_pool.hpp
+ *  \brief Classes for running batches of tasks on a pool of threads.
+ */
+
+#ifndef PRONEST_WORK_STEALING_POOL_HPP
+#define PRONEST_WORK_STEALING_POOL_HPP
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+#include "helper/container.hpp"
+
+namespace ProNest {
+
+using Helper::List;
+using Helper::Map;
+
+//! \brief A shared flag for requesting cancellation of work in progress
+//! \details Copies refer to the same flag, hence a copy can be handed to the work while the original is cancelled
+class CancellationToken {
+  public:
+    CancellationToken();
+
+    //! \brief Request cancellation
+    void cancel();
+    //! \brief Whether cancellation has been requested
+    bool is_cancelled() const;
+
+  private:
+    std::shared_ptr<std::atomic<bool>> _cancelled;
+};
+
+//! \brief A fixed set of worker threads running batches of indexed tasks
+//! \details Each worker owns a queue of indices, initially dealt in contiguous chunks; it takes work from the back of
+//! its own queue and, once empty, steals from the front of the queues of the other workers, so that uneven task
+//! durations are balanced without a central queue. Batches are run one at a time.
+class WorkStealingPool {
+    struct Worker;
+  public:
+    //! \brief Construct with \a concurrency worker threads
+    explicit WorkStealingPool(size_t concurrency);
+    ~WorkStealingPool();
+
+    WorkStealingPool(WorkStealingPool const&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+
+    //! \brief The number of worker threads
+    size_t concurrency() const;
+
+    //! \brief Run \a task on each index in [0,count), returning when all have completed
+    //! \details Indices not yet started when \a cancellation is cancelled are skipped, as are those not yet started
+    //! when a task throws; the first exception thrown is then rethrown. Must not be called from within a task.
+    void run(size_t count, std::function<void(size_t)> const& task, CancellationToken const& cancellation = CancellationToken());
+
+  private:
+    void _loop(size_t worker);
+    //! \brief Take an index for \a worker, from its own queue or else from the other queues
+    bool _take(size_t worker, size_t& index);
+
+  private:
+    List<std::unique_ptr<Worker>> _workers;
+    List<std::thread> _threads;
+    std::mutex _run_mutex;
+    std::mutex _mutex;
+    std::condition_variable _work_available;
+    std::condition_variable _batch_completed;
+    std::function<void(size_t)> const* _task;
+    CancellationToken _cancellation;
+    std::atomic<size_t> _queued;
+    size_t _remaining;
+    std::exception_ptr _exception;
+    bool _stopping;
+};
+
+//! \brief Run \a task on each index in [0,count) using up to \a concurrency threads
+//! \details The tasks run on a pool shared by all the callers with the same \a concurrency, created on first use, so
+//! that no thread is started per call; concurrent callers with the same concurrency take turns. The tasks run in the
+//! calling thread instead if one thread suffices or if called from a task of a pool. Cancellation and exceptions are
+//! as for WorkStealingPool::run.
+void run_concurrently(size_t count, size_t concurrency, std::function<void(size_t)> const& task, CancellationToken const& cancellation = CancellationToken());
+
+} // namespace ProNest
+
+#endif // PRONEST_WORK_STEALING_POOL_HPP
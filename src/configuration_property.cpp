@@ -27,12 +27,28 @@
  */
 
 #include <ostream>
+#include <atomic>
 #include "helper/macros.hpp"
 #include "configuration_property.hpp"
 #include "configuration_property.tpl.hpp"
 
 namespace ProNest {
 
+namespace {
+std::atomic<size_t>& configuration_property_version_counter() {
+    static std::atomic<size_t> counter(0);
+    return counter;
+}
+} // namespace
+
+size_t ConfigurationPropertyInterface::latest_version() {
+    return configuration_property_version_counter().load();
+}
+
+size_t ConfigurationPropertyInterface::next_version() {
+    return ++configuration_property_version_counter();
+}
+
 BooleanConfigurationProperty::BooleanConfigurationProperty()
     : ConfigurationPropertyBase(false), _is_single(false), _value(false)
 { }
@@ -46,6 +62,11 @@ ConfigurationPropertyInterface* BooleanConfigurationProperty::at(ConfigurationPr
     return this;
 }
 
+ConfigurationPropertyInterface const* BooleanConfigurationProperty::at(ConfigurationPropertyPath const& path) const {
+    HELPER_ASSERT_MSG(path.is_root(),"The path " << path << " is not a root but a boolean property can't have configurable objects below.");
+    return this;
+}
+
 bool const& BooleanConfigurationProperty::get() const {
     HELPER_PRECONDITION(this->is_specified());
     HELPER_ASSERT_MSG(this->is_single(),"The property should have a single value when actually used. Are you accessing it outside the related task?");
@@ -89,6 +110,7 @@ void BooleanConfigurationProperty::local_set_single(int integer_value) {
     _is_single = true;
     if (integer_value == 1) _value = true;
     else _value = false;
+    update_version();
 }
 
 ConfigurationPropertyInterface* BooleanConfigurationProperty::clone() const {
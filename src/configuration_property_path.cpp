@@ -26,79 +26,159 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <unordered_map>
 #include "helper/macros.hpp"
 #include "configuration_property_path.hpp"
 
 namespace ProNest {
 
-ConfigurationPropertyPath::ConfigurationPropertyPath(String const& first) {
-    _path.push_back(first);
-}
+//! \brief An interned path, never deallocated
+struct ConfigurationPropertyPathEntry {
+    std::vector<String> nodes;
+    String repr;
+    size_t hash;
+    size_t id;
+    //! \brief The entry for everything but the first node, nullptr for the root
+    ConfigurationPropertyPathEntry const* subpath;
+};
+
+namespace {
+
+class ConfigurationPropertyPathTable {
+  public:
+    static ConfigurationPropertyPathTable& instance() {
+        static ConfigurationPropertyPathTable table;
+        return table;
+    }
 
-ConfigurationPropertyPath::ConfigurationPropertyPath(ConfigurationPropertyPath const& path) {
-    _path = path._path;
-}
+    ConfigurationPropertyPathEntry const* root() const {
+        return _root;
+    }
+
+    ConfigurationPropertyPathEntry const* intern(std::vector<String> const& nodes) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _intern(nodes, 0);
+    }
+
+  private:
+    ConfigurationPropertyPathTable() {
+        _root = _intern({}, 0);
+    }
+
+    //! \brief Intern the path made of the nodes from \a from onwards, along with all its suffixes
+    ConfigurationPropertyPathEntry const* _intern(std::vector<String> const& nodes, size_t from) {
+        String repr = "./";
+        for (size_t i=from; i<nodes.size(); ++i) { repr += nodes[i]; repr += "/"; }
+        auto iter = _entries.find(repr);
+        if (iter != _entries.end()) return iter->second.get();
+        auto entry = std::make_unique<ConfigurationPropertyPathEntry>();
+        entry->nodes.assign(nodes.begin()+static_cast<std::ptrdiff_t>(from), nodes.end());
+        entry->hash = std::hash<String>()(repr);
+        entry->subpath = (from < nodes.size() ? _intern(nodes, from+1) : nullptr);
+        entry->id = _entries.size();
+        entry->repr = repr;
+        auto result = entry.get();
+        _entries.emplace(repr, std::move(entry));
+        return result;
+    }
+
+    std::mutex _mutex;
+    std::unordered_map<String,std::unique_ptr<ConfigurationPropertyPathEntry>> _entries;
+    ConfigurationPropertyPathEntry const* _root;
+};
+
+} // namespace
+
+ConfigurationPropertyPath::ConfigurationPropertyPath() : _entry(ConfigurationPropertyPathTable::instance().root()) { }
+
+ConfigurationPropertyPath::ConfigurationPropertyPath(ConfigurationPropertyPathEntry const* entry) : _entry(entry) { }
+
+ConfigurationPropertyPath::ConfigurationPropertyPath(String const& first)
+    : _entry(ConfigurationPropertyPathTable::instance().intern({first})) { }
+
+ConfigurationPropertyPath::ConfigurationPropertyPath(ConfigurationPropertyPath const& path) : _entry(path._entry) { }
 
 ConfigurationPropertyPath& ConfigurationPropertyPath::operator=(ConfigurationPropertyPath const& path) {
-    _path = path._path;
+    _entry = path._entry;
     return *this;
 }
 
+ConfigurationPropertyPath ConfigurationPropertyPath::parse(std::string_view const& str) {
+    std::vector<String> nodes;
+    size_t begin = 0;
+    while (begin <= str.size()) {
+        size_t end = str.find('/', begin);
+        if (end == std::string_view::npos) end = str.size();
+        auto node = str.substr(begin, end-begin);
+        if (not node.empty() and node != ".") nodes.emplace_back(node);
+        begin = end+1;
+    }
+    return ConfigurationPropertyPathTable::instance().intern(nodes);
+}
+
 bool ConfigurationPropertyPath::operator<(ConfigurationPropertyPath const& path) const {
-    return this->repr() < path.repr();
+    if (_entry == path._entry) return false;
+    return _entry->repr < path._entry->repr;
 }
 
 bool ConfigurationPropertyPath::operator==(ConfigurationPropertyPath const& path) const {
-    return this->repr() == path.repr();
+    return _entry == path._entry;
+}
+
+String const& ConfigurationPropertyPath::repr() const {
+    return _entry->repr;
 }
 
-String ConfigurationPropertyPath::repr() const {
-    std::ostringstream sstream;
-    sstream << *this;
-    return sstream.str();
+size_t ConfigurationPropertyPath::hash() const {
+    return _entry->hash;
+}
+
+size_t ConfigurationPropertyPath::id() const {
+    return _entry->id;
 }
 
 bool ConfigurationPropertyPath::is_root() const {
-    return _path.empty();
+    return _entry->nodes.empty();
 }
 
 ConfigurationPropertyPath& ConfigurationPropertyPath::append(String const& node) {
     HELPER_PRECONDITION(not node.empty());
-    _path.push_back(node);
+    auto nodes = _entry->nodes;
+    nodes.push_back(node);
+    _entry = ConfigurationPropertyPathTable::instance().intern(nodes);
     return *this;
 }
 
 ConfigurationPropertyPath& ConfigurationPropertyPath::prepend(String const& node) {
     HELPER_PRECONDITION(not node.empty());
-    _path.push_front(node);
+    std::vector<String> nodes;
+    nodes.reserve(_entry->nodes.size()+1);
+    nodes.push_back(node);
+    nodes.insert(nodes.end(), _entry->nodes.begin(), _entry->nodes.end());
+    _entry = ConfigurationPropertyPathTable::instance().intern(nodes);
     return *this;
 }
 
-String ConfigurationPropertyPath::first() const {
+String const& ConfigurationPropertyPath::first() const {
     HELPER_PRECONDITION(not is_root());
-    return _path.front();
+    return _entry->nodes.front();
 }
 
-String ConfigurationPropertyPath::last() const {
+String const& ConfigurationPropertyPath::last() const {
     HELPER_PRECONDITION(not is_root());
-    return _path.back();
+    return _entry->nodes.back();
 }
 
 ConfigurationPropertyPath ConfigurationPropertyPath::subpath() const {
-    auto result = *this;
-    result._path.pop_front();
-    return result;
+    if (is_root()) return *this;
+    return _entry->subpath;
 }
 
 std::ostream& operator<<(std::ostream& os, ConfigurationPropertyPath const& p) {
-    auto size = p._path.size();
-    auto iter = p._path.begin();
-    os << "./";
-    for (std::size_t i=0; i<size; ++i) {
-        os << *iter << "/";
-        ++iter;
-    }
-    return os;
+    return os << p._entry->repr;
 }
 
 } // namespace ProNest
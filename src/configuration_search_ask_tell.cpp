@@ -0,0 +1,141 @@
+/***************************************************************************
+ *            src/configuration_search_ask_tell.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "configuration_search_ask_tell.hpp"
+
+namespace ProNest {
+
+namespace {
+
+class SampledAskTell : public ConfigurationSearchAskTellOptimiser {
+  public:
+    SampledAskTell(ConfigurationSearchSpace const& space, size_t budget, ConfigurationSearchSampling sampling, RandomEngine engine)
+        : ConfigurationSearchAskTellOptimiser(space, budget), _sampling(sampling), _engine(engine) { }
+
+  protected:
+    List<ConfigurationSearchPoint> propose(size_t amount) override {
+        // The sample is drawn on first use, so that construction is cheap
+        if (not _sample.has_value()) _sample = make_sampled_points(space(), std::min(budget(), space().total_points()), _sampling, _engine);
+        List<ConfigurationSearchPoint> result;
+        for (; _next < _sample->size() and result.size() < amount; ++_next) result.push_back((*_sample)[_next]);
+        return result;
+    }
+
+    void observe(ConfigurationSearchPoint const&, double) override { }
+
+  private:
+    ConfigurationSearchSampling _sampling;
+    RandomEngine _engine;
+    std::optional<List<ConfigurationSearchPoint>> _sample;
+    size_t _next = 0;
+};
+
+} // namespace
+
+ConfigurationSearchAskTellOptimiser::ConfigurationSearchAskTellOptimiser(ConfigurationSearchSpace const& space, size_t budget)
+    : _space(space), _budget(budget), _best_cost(0.0), _is_exhausted(false) { }
+
+List<ConfigurationSearchPoint> ConfigurationSearchAskTellOptimiser::ask(size_t amount) {
+    size_t const remaining = _budget - num_asked();
+    if (remaining == 0 or _is_exhausted or amount == 0) return {};
+    auto result = propose(std::min(amount, remaining));
+    HELPER_ASSERT_MSG(result.size() <= std::min(amount, remaining),"The search proposed " << result.size() << " points, more than the " << std::min(amount, remaining) << " asked.");
+    for (auto const& point : result) {
+        HELPER_ASSERT_MSG(not is_asked(point),"The search proposed the point " << point << " which has already been asked.");
+        _pending.insert(point);
+    }
+    if (result.empty() and _pending.empty()) _is_exhausted = true;
+    return result;
+}
+
+void ConfigurationSearchAskTellOptimiser::tell(ConfigurationSearchPoint const& point, double cost) {
+    auto iter = _pending.find(point);
+    HELPER_PRECONDITION(iter != _pending.end())
+    _pending.erase(iter);
+    _told.insert({point, cost});
+    if (not _best.has_value() or cost < _best_cost) {
+        _best = point;
+        _best_cost = cost;
+    }
+    observe(point, cost);
+}
+
+bool ConfigurationSearchAskTellOptimiser::is_finished() const {
+    return (num_asked() == _budget or _is_exhausted) and _pending.empty();
+}
+
+ConfigurationSearchSpace const& ConfigurationSearchAskTellOptimiser::space() const {
+    return _space;
+}
+
+size_t ConfigurationSearchAskTellOptimiser::budget() const {
+    return _budget;
+}
+
+size_t ConfigurationSearchAskTellOptimiser::num_asked() const {
+    return _pending.size() + _told.size();
+}
+
+size_t ConfigurationSearchAskTellOptimiser::num_told() const {
+    return _told.size();
+}
+
+size_t ConfigurationSearchAskTellOptimiser::num_pending() const {
+    return _pending.size();
+}
+
+bool ConfigurationSearchAskTellOptimiser::has_best() const {
+    return _best.has_value();
+}
+
+ConfigurationSearchPoint const& ConfigurationSearchAskTellOptimiser::best() const {
+    HELPER_PRECONDITION(has_best())
+    return *_best;
+}
+
+double ConfigurationSearchAskTellOptimiser::best_cost() const {
+    HELPER_PRECONDITION(has_best())
+    return _best_cost;
+}
+
+bool ConfigurationSearchAskTellOptimiser::is_asked(ConfigurationSearchPoint const& point) const {
+    return _pending.contains(point) or _told.contains(point);
+}
+
+std::optional<double> ConfigurationSearchAskTellOptimiser::told_cost(ConfigurationSearchPoint const& point) const {
+    auto iter = _told.find(point);
+    if (iter == _told.end()) return std::nullopt;
+    return iter->second;
+}
+
+std::shared_ptr<ConfigurationSearchAskTellOptimiser> make_sampled_ask_tell(ConfigurationSearchSpace const& space, size_t budget,
+                                                                           ConfigurationSearchSampling sampling, RandomEngine& engine) {
+    return std::make_shared<SampledAskTell>(space, budget, sampling, engine.split());
+}
+
+} // namespace ProNest
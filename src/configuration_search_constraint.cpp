@@ -0,0 +1,99 @@
+/***************************************************************************
+ *            configuration_search_constraint.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <sstream>
+#include "helper/macros.hpp"
+#include "configuration_search_constraint.hpp"
+
+namespace ProNest {
+
+ConfigurationSearchConstraint::ConfigurationSearchConstraint(String const& description, List<ConfigurationPropertyPath> const& paths, Predicate const& predicate)
+    : _description(description), _paths(paths), _predicate(std::make_shared<Predicate const>(predicate)) {
+    HELPER_PRECONDITION(not paths.empty())
+    HELPER_PRECONDITION(predicate != nullptr)
+}
+
+ConfigurationSearchConstraint::ConfigurationSearchConstraint(String const& description, List<ConfigurationPropertyPath> const& paths, std::shared_ptr<Predicate const> const& predicate)
+    : _description(description), _paths(paths), _predicate(predicate) { }
+
+ConfigurationSearchConstraint ConfigurationSearchConstraint::less_or_equal(ConfigurationPropertyPath const& lower, ConfigurationPropertyPath const& upper) {
+    static auto const predicate = std::make_shared<Predicate const>([](List<int> const& values) { return values[0] <= values[1]; });
+    std::ostringstream ss;
+    ss << lower << " <= " << upper;
+    return {ss.str(), {lower, upper}, predicate};
+}
+
+String const& ConfigurationSearchConstraint::description() const {
+    return _description;
+}
+
+List<ConfigurationPropertyPath> const& ConfigurationSearchConstraint::paths() const {
+    return _paths;
+}
+
+bool ConfigurationSearchConstraint::is_satisfied_by(List<int> const& values) const {
+    HELPER_PRECONDITION(values.size() == _paths.size())
+    if (_bound_values.empty()) return (*_predicate)(values);
+    List<int> all_values;
+    all_values.reserve(_paths.size()+_bound_values.size());
+    auto bound_ptr = _bound_values.begin();
+    for (auto v : values) {
+        while (bound_ptr != _bound_values.end() and bound_ptr->first == all_values.size()) all_values.push_back((bound_ptr++)->second);
+        all_values.push_back(v);
+    }
+    for (; bound_ptr != _bound_values.end(); ++bound_ptr) all_values.push_back(bound_ptr->second);
+    return (*_predicate)(all_values);
+}
+
+ConfigurationSearchConstraint ConfigurationSearchConstraint::bind(Map<ConfigurationPropertyPath,int> const& values) const {
+    ConfigurationSearchConstraint result(_description, {}, _predicate);
+    auto bound_ptr = _bound_values.begin();
+    auto path_ptr = _paths.begin();
+    for (size_t i=0; i<_paths.size()+_bound_values.size(); ++i) {
+        if (bound_ptr != _bound_values.end() and bound_ptr->first == i) {
+            result._bound_values.push_back(*bound_ptr++);
+            continue;
+        }
+        auto value_ptr = values.find(*path_ptr);
+        if (value_ptr == values.end()) result._paths.push_back(*path_ptr);
+        else result._bound_values.push_back({i, value_ptr->second});
+        ++path_ptr;
+    }
+    HELPER_ASSERT_MSG(not result._paths.empty(),"All the paths of constraint '" << *this << "' would be bound.");
+    return result;
+}
+
+bool ConfigurationSearchConstraint::operator==(ConfigurationSearchConstraint const& other) const {
+    return _predicate == other._predicate and _description == other._description and _paths == other._paths and _bound_values == other._bound_values;
+}
+
+ostream& operator<<(ostream& os, ConfigurationSearchConstraint const& constraint) {
+    return os << constraint._description;
+}
+
+} // namespace ProNest
@@ -0,0 +1,144 @@
+/***************************************************************************
+ *            src/configuration_search_coroutine.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "configuration_search_coroutine.hpp"
+
+namespace ProNest {
+
+ConfigurationSearchCompletion::ConfigurationSearchCompletion() : _state(std::make_shared<State>()) { }
+
+void ConfigurationSearchCompletion::complete(double cost) {
+    _resolve(cost, nullptr);
+}
+
+void ConfigurationSearchCompletion::fail(std::exception_ptr error) {
+    HELPER_PRECONDITION(error != nullptr)
+    _resolve(std::nullopt, std::move(error));
+}
+
+void ConfigurationSearchCompletion::_resolve(std::optional<double> cost, std::exception_ptr error) {
+    std::coroutine_handle<> waiter;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        HELPER_ASSERT_MSG(not _state->is_resolved,"The completion has already been resolved.");
+        _state->is_resolved = true;
+        _state->cost = cost;
+        _state->error = std::move(error);
+        std::swap(waiter, _state->waiter);
+    }
+    if (waiter) waiter.resume();
+}
+
+bool ConfigurationSearchCompletion::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (_state->is_resolved) return false;
+    HELPER_ASSERT_MSG(not _state->waiter,"The completion is already awaited by another coroutine.");
+    _state->waiter = handle;
+    return true;
+}
+
+double ConfigurationSearchCompletion::await_resume() {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (_state->error != nullptr) std::rethrow_exception(_state->error);
+    return *_state->cost;
+}
+
+bool ConfigurationSearchAskTellDriver::AskAwaitable::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(_driver._mutex);
+    auto points = _driver._optimiser->ask(1);
+    if (not points.empty()) {
+        _point = std::move(points.front());
+        return false;
+    }
+    if (_driver._optimiser->is_finished()) {
+        _driver._finished.notify_all();
+        return false;
+    }
+    _handle = handle;
+    _driver._waiting.push_back(this);
+    return true;
+}
+
+ConfigurationSearchAskTellDriver::ConfigurationSearchAskTellDriver(std::shared_ptr<ConfigurationSearchAskTellOptimiser> optimiser)
+    : _optimiser(std::move(optimiser)) {
+    HELPER_PRECONDITION(_optimiser != nullptr)
+}
+
+auto ConfigurationSearchAskTellDriver::ask() -> AskAwaitable {
+    return AskAwaitable(*this);
+}
+
+void ConfigurationSearchAskTellDriver::tell(ConfigurationSearchPoint const& point, double cost) {
+    List<AskAwaitable*> resumed;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _optimiser->tell(point, cost);
+        if (not _waiting.empty()) {
+            // The points are asked together, which lets the search propose them as a batch
+            auto points = _optimiser->ask(_waiting.size());
+            for (auto& p : points) {
+                _waiting.front()->_point = std::move(p);
+                resumed.push_back(_waiting.front());
+                _waiting.pop_front();
+            }
+        }
+        if (_optimiser->is_finished()) {
+            for (auto* awaitable : _waiting) resumed.push_back(awaitable);
+            _waiting.clear();
+            _finished.notify_all();
+        }
+    }
+    for (auto* awaitable : resumed) awaitable->_handle.resume();
+}
+
+void ConfigurationSearchAskTellDriver::wait() const {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _finished.wait(lock, [this]() { return _optimiser->is_finished(); });
+}
+
+bool ConfigurationSearchAskTellDriver::is_finished() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _optimiser->is_finished();
+}
+
+size_t ConfigurationSearchAskTellDriver::num_waiting() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _waiting.size();
+}
+
+ConfigurationSearchPoint ConfigurationSearchAskTellDriver::best() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _optimiser->best();
+}
+
+double ConfigurationSearchAskTellDriver::best_cost() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _optimiser->best_cost();
+}
+
+} // namespace ProNest
@@ -0,0 +1,115 @@
+/***************************************************************************
+ *            configuration_search_evaluation_cache.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "configuration_search_evaluation_cache.hpp"
+
+namespace ProNest {
+
+struct ConfigurationSearchEvaluationCache::Shard {
+    using Entries = std::list<std::pair<ConfigurationSearchPoint,double>>;
+    std::mutex mutex;
+    size_t capacity;
+    //! \brief The entries from the most to the least recently used
+    Entries entries;
+    std::unordered_map<ConfigurationSearchPoint,Entries::iterator> positions;
+};
+
+ConfigurationSearchEvaluationCache::ConfigurationSearchEvaluationCache(size_t capacity, size_t num_shards) : _capacity(capacity), _hits(0), _misses(0), _evictions(0) {
+    HELPER_PRECONDITION(capacity > 0)
+    HELPER_PRECONDITION(num_shards > 0)
+    num_shards = std::min(num_shards, capacity);
+    for (size_t s=0; s<num_shards; ++s) {
+        _shards.push_back(std::make_unique<Shard>());
+        _shards.back()->capacity = capacity*(s+1)/num_shards - capacity*s/num_shards;
+    }
+}
+
+ConfigurationSearchEvaluationCache::~ConfigurationSearchEvaluationCache() = default;
+
+auto ConfigurationSearchEvaluationCache::_shard(ConfigurationSearchPoint const& point) const -> Shard& {
+    // The hash is mixed, so that the shard is not correlated with the bucket in the map of the shard
+    return *_shards[((static_cast<uint64_t>(point.hash())*0x9e3779b97f4a7c15ULL) >> 32) % _shards.size()];
+}
+
+std::optional<double> ConfigurationSearchEvaluationCache::find(ConfigurationSearchPoint const& point) {
+    auto& shard = _shard(point);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.positions.find(point);
+    if (iter == shard.positions.end()) {
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    _hits.fetch_add(1, std::memory_order_relaxed);
+    shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+    return iter->second->second;
+}
+
+void ConfigurationSearchEvaluationCache::insert(ConfigurationSearchPoint const& point, double cost) {
+    auto& shard = _shard(point);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.positions.find(point);
+    if (iter != shard.positions.end()) {
+        iter->second->second = cost;
+        shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+        return;
+    }
+    if (shard.entries.size() == shard.capacity) {
+        shard.positions.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+        _evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.entries.emplace_front(point, cost);
+    shard.positions.emplace(point, shard.entries.begin());
+}
+
+size_t ConfigurationSearchEvaluationCache::size() const {
+    size_t result = 0;
+    for (auto const& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        result += shard->entries.size();
+    }
+    return result;
+}
+
+size_t ConfigurationSearchEvaluationCache::capacity() const {
+    return _capacity;
+}
+
+void ConfigurationSearchEvaluationCache::clear() {
+    for (auto& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->positions.clear();
+        shard->entries.clear();
+    }
+}
+
+ConfigurationSearchEvaluationCacheStatistics ConfigurationSearchEvaluationCache::statistics() const {
+    return {_hits.load(std::memory_order_relaxed), _misses.load(std::memory_order_relaxed), _evictions.load(std::memory_order_relaxed)};
+}
+
+} // namespace ProNest
@@ -0,0 +1,261 @@
+/***************************************************************************
+ *            configuration_search_evolution.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+#include "configuration_search_evolution.hpp"
+#include "configuration_search_sampling.hpp"
+#include "configuration_search_evaluator.hpp"
+#include "configuration_search_point_set.hpp"
+
+namespace ProNest {
+
+namespace {
+
+//! \brief The maximum number of attempts at drawing a feasible child
+constexpr size_t MAXIMUM_CHILD_ATTEMPTS = 8;
+
+//! \brief The first \a depth nodes of \a path, or the whole path if not longer
+ConfigurationPropertyPath prefix_of(ConfigurationPropertyPath const& path, size_t depth) {
+    ConfigurationPropertyPath result;
+    size_t n = 0;
+    for (auto rest = path; not rest.is_root() and n < depth; rest = rest.subpath(), ++n) result.append(rest.first());
+    return result;
+}
+
+//! \brief The indices of the parameters of \a space grouped by PATH_PREFIX crossover with the given \a depth, in order of first parameter
+List<List<size_t>> crossover_blocks(ConfigurationSearchSpace const& space, size_t depth) {
+    List<List<size_t>> result;
+    std::unordered_map<ConfigurationPropertyPath,size_t> block_of_prefix;
+    auto const& parameters = space.parameters();
+    for (size_t i=0; i<parameters.size(); ++i) {
+        auto prefix = prefix_of(parameters[i].path(), depth);
+        auto iter = block_of_prefix.find(prefix);
+        if (iter == block_of_prefix.end()) {
+            block_of_prefix.insert({prefix, result.size()});
+            result.push_back({i});
+        } else result[iter->second].push_back(i);
+    }
+    return result;
+}
+
+ConfigurationSearchPoint make_crossover(ConfigurationSearchPoint const& first, ConfigurationSearchPoint const& second, List<List<size_t>> const& blocks, RandomEngine& engine) {
+    List<int> coordinates = first.coordinates();
+    for (auto const& block : blocks)
+        if (engine.uniform<size_t>(0,1) == 1)
+            for (auto i : block) coordinates[i] = second.value(i);
+    return first.space().make_point(coordinates);
+}
+
+List<List<size_t>> blocks_for(ConfigurationSearchSpace const& space, ConfigurationSearchCrossover crossover, size_t depth) {
+    if (crossover == ConfigurationSearchCrossover::PATH_PREFIX) return crossover_blocks(space, depth);
+    List<List<size_t>> result;
+    for (size_t i=0; i<space.dimension(); ++i) result.push_back({i});
+    return result;
+}
+
+//! \brief A population with the costs, sorted by increasing cost
+using Population = List<std::pair<ConfigurationSearchPoint,double>>;
+
+//! \brief A feasible child of parents chosen by tournament from the non-empty \a population, or else the first parent
+ConfigurationSearchPoint make_population_child(ConfigurationSearchSpace const& space, Population const& population, List<List<size_t>> const& blocks,
+                                               double crossover_probability, double mutation_probability, size_t tournament_size, RandomEngine& engine) {
+    auto tournament = [&]() -> ConfigurationSearchPoint const& {
+        // The population is sorted, hence the lowest position drawn wins
+        size_t winner = population.size();
+        for (size_t i=0; i<tournament_size; ++i) winner = std::min(winner, engine.uniform<size_t>(0,population.size()-1));
+        return population[winner].first;
+    };
+
+    auto const& first = tournament();
+    for (size_t attempt=0; attempt<MAXIMUM_CHILD_ATTEMPTS; ++attempt) {
+        auto child = first;
+        if (engine.canonical() < crossover_probability) child = make_crossover(first, tournament(), blocks, engine);
+        if (engine.canonical() < mutation_probability) {
+            auto const neighbours = child.neighbours();
+            if (not neighbours.empty()) child = neighbours[engine.uniform<size_t>(0,neighbours.size()-1)];
+        }
+        if (space.is_feasible(child)) return child;
+    }
+    return first;
+}
+
+class EvolutionAskTell : public ConfigurationSearchAskTellOptimiser {
+  public:
+    EvolutionAskTell(ConfigurationSearchSpace const& space, size_t budget, size_t population_size, List<List<size_t>> const& blocks,
+                     double crossover_probability, double mutation_probability, size_t tournament_size, RandomEngine engine)
+        : ConfigurationSearchAskTellOptimiser(space, budget), _population_size(std::min(population_size, space.total_points())), _blocks(blocks),
+          _crossover_probability(crossover_probability), _mutation_probability(mutation_probability), _tournament_size(tournament_size), _engine(engine) { }
+
+  protected:
+    List<ConfigurationSearchPoint> propose(size_t amount) override {
+        if (not _initial.has_value()) _initial = make_sampled_points(space(), _population_size, ConfigurationSearchSampling::LATIN_HYPERCUBE, _engine);
+        ConfigurationSearchPointSet result;
+        auto is_new = [&](ConfigurationSearchPoint const& point) { return not is_asked(point) and not result.contains(point); };
+        while (result.size() < amount) {
+            if (_next_initial < _initial->size()) {
+                result.insert((*_initial)[_next_initial++]);
+                continue;
+            }
+            if (_population.empty()) break;
+            std::optional<ConfigurationSearchPoint> child;
+            for (size_t attempt=0; attempt<MAXIMUM_CHILD_ATTEMPTS and not child.has_value(); ++attempt) {
+                auto point = make_population_child(space(), _population, _blocks, _crossover_probability, _mutation_probability, _tournament_size, _engine);
+                if (is_new(point)) child = point;
+            }
+            // A random point keeps the search going when the children have all been asked already
+            for (size_t attempt=0; attempt<MAXIMUM_CHILD_ATTEMPTS and not child.has_value(); ++attempt) {
+                auto point = space().initial_point(_engine);
+                if (is_new(point)) child = point;
+            }
+            if (not child.has_value()) break;
+            result.insert(*child);
+        }
+        return result.points();
+    }
+
+    void observe(ConfigurationSearchPoint const& point, double cost) override {
+        auto position = std::upper_bound(_population.begin(), _population.end(), cost, [](double c, auto const& p) { return c < p.second; });
+        _population.insert(position, {point, cost});
+        if (_population.size() > _population_size) _population.pop_back();
+    }
+
+  private:
+    size_t _population_size;
+    List<List<size_t>> _blocks;
+    double _crossover_probability;
+    double _mutation_probability;
+    size_t _tournament_size;
+    RandomEngine _engine;
+    std::optional<List<ConfigurationSearchPoint>> _initial;
+    size_t _next_initial = 0;
+    Population _population;
+};
+
+} // namespace
+
+ConfigurationSearchPoint make_crossover(ConfigurationSearchPoint const& first, ConfigurationSearchPoint const& second, ConfigurationSearchCrossover crossover,
+                                        RandomEngine& engine, size_t prefix_depth) {
+    HELPER_PRECONDITION(first.space() == second.space());
+    HELPER_PRECONDITION(prefix_depth > 0);
+    return make_crossover(first, second, blocks_for(first.space(), crossover, prefix_depth), engine);
+}
+
+ConfigurationSearchEvolution::ConfigurationSearchEvolution(size_t population_size, size_t num_generations)
+    : _population_size(population_size), _num_generations(num_generations), _crossover(ConfigurationSearchCrossover::UNIFORM), _prefix_depth(1),
+      _crossover_probability(0.9), _mutation_probability(0.2), _tournament_size(2), _num_elites(1), _concurrency(1) {
+    HELPER_PRECONDITION(population_size > 1)
+}
+
+void ConfigurationSearchEvolution::set_crossover(ConfigurationSearchCrossover crossover, size_t prefix_depth) {
+    HELPER_PRECONDITION(prefix_depth > 0)
+    _crossover = crossover;
+    _prefix_depth = prefix_depth;
+}
+
+void ConfigurationSearchEvolution::set_crossover_probability(double probability) {
+    HELPER_PRECONDITION(probability >= 0 and probability <= 1)
+    _crossover_probability = probability;
+}
+
+void ConfigurationSearchEvolution::set_mutation_probability(double probability) {
+    HELPER_PRECONDITION(probability >= 0 and probability <= 1)
+    _mutation_probability = probability;
+}
+
+void ConfigurationSearchEvolution::set_tournament_size(size_t size) {
+    HELPER_PRECONDITION(size > 0)
+    _tournament_size = size;
+}
+
+void ConfigurationSearchEvolution::set_num_elites(size_t num_elites) {
+    HELPER_PRECONDITION(num_elites < _population_size)
+    _num_elites = num_elites;
+}
+
+void ConfigurationSearchEvolution::set_concurrency(size_t concurrency) {
+    HELPER_PRECONDITION(concurrency > 0)
+    _concurrency = concurrency;
+}
+
+void ConfigurationSearchEvolution::set_cache(std::shared_ptr<ConfigurationSearchEvaluationCache> cache) {
+    _cache = std::move(cache);
+}
+
+size_t ConfigurationSearchEvolution::population_size() const {
+    return _population_size;
+}
+
+size_t ConfigurationSearchEvolution::num_generations() const {
+    return _num_generations;
+}
+
+ConfigurationSearchEvolutionResult ConfigurationSearchEvolution::evolve(ConfigurationSearchSpace const& space, Cost const& cost,
+                                                                        RandomEngine& engine, CancellationToken const& cancellation) const {
+    size_t const population_size = std::min(_population_size, space.total_points());
+    auto const blocks = blocks_for(space, _crossover, _prefix_depth);
+    ConfigurationSearchEvaluator evaluator(_concurrency, _cache);
+    size_t num_evaluations = 0;
+
+    auto evaluate = [&](List<ConfigurationSearchPoint> const& points, CancellationToken const& token) {
+        Population evaluated;
+        for (auto& evaluation : evaluator.evaluate(points, cost, token)) {
+            if (not evaluation.is_cached) ++num_evaluations;
+            evaluated.emplace_back(std::move(evaluation.point), evaluation.cost);
+        }
+        return evaluated;
+    };
+
+    // The initial population is never cut short, so that there is always a best point
+    Population population = evaluate(make_sampled_points(space, population_size, ConfigurationSearchSampling::LATIN_HYPERCUBE, engine), CancellationToken());
+    List<double> generation_best_costs;
+    generation_best_costs.push_back(population.front().second);
+
+    for (size_t g=0; g<_num_generations and not cancellation.is_cancelled(); ++g) {
+        List<ConfigurationSearchPoint> children;
+        size_t const num_elites = std::min(_num_elites, population_size);
+        for (size_t i=num_elites; i<population_size; ++i)
+            children.push_back(make_population_child(space, population, blocks, _crossover_probability, _mutation_probability, _tournament_size, engine));
+        auto evaluated = evaluate(children, cancellation);
+        if (evaluated.size() < children.size()) break;
+        population.resize(num_elites, population.front());
+        population.insert(population.end(), evaluated.begin(), evaluated.end());
+        std::stable_sort(population.begin(), population.end(), [](auto const& a, auto const& b) { return a.second < b.second; });
+        generation_best_costs.push_back(population.front().second);
+    }
+
+    return {population.front().first, population.front().second, generation_best_costs, num_evaluations};
+}
+
+std::shared_ptr<ConfigurationSearchAskTellOptimiser> ConfigurationSearchEvolution::make_ask_tell(ConfigurationSearchSpace const& space, size_t budget, RandomEngine& engine) const {
+    return std::make_shared<EvolutionAskTell>(space, budget, _population_size, blocks_for(space, _crossover, _prefix_depth), _crossover_probability,
+                                              _mutation_probability, _tournament_size, engine.split());
+}
+
+} // namespace ProNest
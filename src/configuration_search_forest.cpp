@@ -0,0 +1,185 @@
+/***************************************************************************
+ *            configuration_search_forest.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <numeric>
+#include <algorithm>
+#include "configuration_search_forest.hpp"
+
+namespace ProNest {
+
+namespace {
+
+//! \brief The sum and the sum of squares of outputs, for computing the squared error of a group
+struct Moments {
+    double sum = 0.0;
+    double sum_of_squares = 0.0;
+    size_t count = 0;
+
+    void add(double y) { sum += y; sum_of_squares += y*y; ++count; }
+    void remove(double y) { sum -= y; sum_of_squares -= y*y; --count; }
+    double squared_error() const { return (count == 0 ? 0.0 : sum_of_squares - sum*sum/static_cast<double>(count)); }
+};
+
+} // namespace
+
+class ConfigurationSearchForest::TreeGrower {
+  public:
+    TreeGrower(List<bool> const& is_metric, List<List<int>> const& inputs, List<double> const& outputs,
+               size_t minimum_split_size, size_t maximum_depth, RandomEngine& engine)
+        : _is_metric(is_metric), _inputs(inputs), _outputs(outputs), _minimum_split_size(minimum_split_size),
+          _maximum_depth(maximum_depth), _engine(engine) { }
+
+    //! \brief Grow on the given \a samples, as indices of the observations possibly repeated, into \a nodes
+    void grow(List<size_t> samples, Tree& nodes) {
+        nodes.push_back({});
+        _grow(samples.begin(), samples.end(), 0, 0, nodes);
+    }
+
+  private:
+    using Iterator = List<size_t>::iterator;
+
+    void _grow(Iterator begin, Iterator end, size_t node, size_t depth, Tree& nodes) {
+        auto const num_parameters = _is_metric.size();
+        Moments all;
+        for (auto it=begin; it!=end; ++it) all.add(_outputs[*it]);
+        nodes[node] = {num_parameters, 0, false, 0, all.sum/static_cast<double>(all.count)};
+        if (all.count < _minimum_split_size or depth >= _maximum_depth or all.squared_error() <= 0.0) return;
+
+        // A random subset of about five sixths of the parameters is considered
+        List<size_t> candidates(num_parameters);
+        std::iota(candidates.begin(),candidates.end(),0);
+        std::shuffle(candidates.begin(),candidates.end(),_engine);
+        candidates.resize(std::max<size_t>(1,(5*num_parameters+5)/6));
+
+        double best_error = all.squared_error();
+        Node best = nodes[node];
+        for (auto p : candidates) {
+            std::sort(begin, end, [&](size_t a, size_t b) { return _inputs[a][p] < _inputs[b][p]; });
+            if (_is_metric[p]) {
+                Moments left, right = all;
+                for (auto it=begin; it+1!=end; ++it) {
+                    left.add(_outputs[*it]);
+                    right.remove(_outputs[*it]);
+                    int const value = _inputs[*it][p];
+                    if (value == _inputs[*(it+1)][p]) continue;
+                    double const error = left.squared_error() + right.squared_error();
+                    if (error < best_error) { best_error = error; best = {p, value, true, 0, 0.0}; }
+                }
+            } else {
+                for (auto it=begin; it!=end;) {
+                    Moments equal;
+                    int const value = _inputs[*it][p];
+                    for (; it!=end and _inputs[*it][p] == value; ++it) equal.add(_outputs[*it]);
+                    if (equal.count == all.count) break;
+                    Moments rest{all.sum - equal.sum, all.sum_of_squares - equal.sum_of_squares, all.count - equal.count};
+                    double const error = equal.squared_error() + rest.squared_error();
+                    if (error < best_error) { best_error = error; best = {p, value, false, 0, 0.0}; }
+                }
+            }
+        }
+        if (best.parameter == num_parameters) return;
+
+        auto const middle = std::partition(begin, end, [&](size_t s) {
+            int const v = _inputs[s][best.parameter];
+            return (best.is_metric ? v <= best.value : v == best.value);
+        });
+        best.children = nodes.size();
+        nodes[node] = best;
+        nodes.push_back({});
+        nodes.push_back({});
+        _grow(begin, middle, best.children, depth+1, nodes);
+        _grow(middle, end, best.children+1, depth+1, nodes);
+    }
+
+  private:
+    List<bool> const& _is_metric;
+    List<List<int>> const& _inputs;
+    List<double> const& _outputs;
+    size_t const _minimum_split_size;
+    size_t const _maximum_depth;
+    RandomEngine& _engine;
+};
+
+ConfigurationSearchForest::ConfigurationSearchForest(size_t num_trees, size_t minimum_split_size, size_t maximum_depth)
+    : _num_trees(num_trees), _minimum_split_size(minimum_split_size), _maximum_depth(maximum_depth) {
+    HELPER_PRECONDITION(num_trees > 0)
+    HELPER_PRECONDITION(minimum_split_size > 1)
+}
+
+void ConfigurationSearchForest::add(ConfigurationSearchPoint const& point, double cost) {
+    if (_inputs.empty()) {
+        for (auto const& p : point.space().parameters()) _is_metric.push_back(p.is_metric());
+    }
+    HELPER_PRECONDITION(point.coordinates().size() == _is_metric.size())
+    _inputs.push_back(point.coordinates());
+    _outputs.push_back(cost);
+}
+
+size_t ConfigurationSearchForest::num_observations() const {
+    return _inputs.size();
+}
+
+void ConfigurationSearchForest::fit(RandomEngine& engine, size_t concurrency) {
+    HELPER_PRECONDITION(concurrency > 0)
+    HELPER_PRECONDITION(not _inputs.empty())
+    List<Tree> trees(_num_trees);
+    List<RandomEngine> engines;
+    for (size_t t=0; t<_num_trees; ++t) engines.push_back(engine.split());
+    auto grow = [&](size_t t) {
+        List<size_t> samples(_inputs.size());
+        for (auto& s : samples) s = engines[t].uniform<size_t>(0,_inputs.size()-1);
+        TreeGrower(_is_metric, _inputs, _outputs, _minimum_split_size, _maximum_depth, engines[t]).grow(samples, trees[t]);
+    };
+
+    run_concurrently(_num_trees, concurrency, grow);
+    _trees = std::move(trees);
+}
+
+bool ConfigurationSearchForest::is_fitted() const {
+    return not _trees.empty();
+}
+
+ConfigurationSearchPrediction ConfigurationSearchForest::predict(ConfigurationSearchPoint const& point) const {
+    HELPER_PRECONDITION(is_fitted())
+    auto const& x = point.coordinates();
+    HELPER_PRECONDITION(x.size() == _is_metric.size())
+    Moments outputs;
+    for (auto const& tree : _trees) {
+        size_t n = 0;
+        while (tree[n].parameter != _is_metric.size()) {
+            auto const& node = tree[n];
+            int const v = x[node.parameter];
+            n = node.children + ((node.is_metric ? v <= node.value : v == node.value) ? 0 : 1);
+        }
+        outputs.add(tree[n].output);
+    }
+    double const count = static_cast<double>(outputs.count);
+    return {outputs.sum/count, std::max(0.0, outputs.squared_error()/count)};
+}
+
+} // namespace ProNest
@@ -0,0 +1,377 @@
+/***************************************************************************
+ *            configuration_search_local_search.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <barrier>
+#include <limits>
+#include <numeric>
+#include <unordered_set>
+#include "configuration_search_local_search.hpp"
+
+namespace ProNest {
+
+namespace {
+
+//! \brief A chain of points moved to by accepting or rejecting random neighbours, common to both modes of the search
+class Chain {
+  public:
+    Chain(RandomEngine const& e, double factor, size_t tabu_tenure, size_t restart_after)
+        : engine(e), temperature_factor(factor), _tabu_tenure(tabu_tenure), _restart_after(restart_after) { }
+
+    //! \brief A random neighbour of the current point not in the tabu list, if any
+    std::optional<ConfigurationSearchPoint> draw() {
+        auto const neighbours = current->neighbours();
+        if (neighbours.empty()) return std::nullopt;
+        if (_tabu_tenure == 0) return neighbours[engine.uniform<size_t>(0,neighbours.size()-1)];
+        List<size_t> indices(neighbours.size());
+        std::iota(indices.begin(),indices.end(),0);
+        for (size_t i=0; i<indices.size(); ++i) {
+            std::swap(indices[i],indices[engine.uniform<size_t>(i,indices.size()-1)]);
+            auto point = neighbours[indices[i]];
+            if (not _tabu_hashes.contains(point.hash())) return point;
+        }
+        return std::nullopt;
+    }
+
+    //! \brief Move to \a point of \a cost, making it tabu
+    //! \return Whether \a cost improves on the best cost of the chain
+    bool move_to(ConfigurationSearchPoint const& point, double cost) {
+        current = point;
+        current_cost = cost;
+        if (_tabu_tenure > 0) {
+            auto const hash = point.hash();
+            _tabu.push_back(hash);
+            _tabu_hashes.insert(hash);
+            if (_tabu.size() > _tabu_tenure) {
+                _tabu_hashes.erase(_tabu_hashes.find(_tabu.front()));
+                _tabu.pop_front();
+            }
+        }
+        if (not (cost < best_cost)) return false;
+        best_cost = cost;
+        _stalled_steps = 0;
+        return true;
+    }
+
+    //! \brief Move to \a point of \a cost as a new start, with no stalled steps
+    bool restart_from(ConfigurationSearchPoint const& point, double cost) {
+        needs_restart = false;
+        _stalled_steps = 0;
+        return move_to(point, cost);
+    }
+
+    //! \brief Move to the \a candidate of \a cost if accepted at \a temperature, and flag a restart once stalled
+    //! \return Whether \a cost improves on the best cost of the chain, even if the candidate is rejected
+    bool step(ConfigurationSearchPoint const& candidate, double cost, double temperature) {
+        double const delta = cost - current_cost;
+        bool const improves = (cost < best_cost);
+        if (delta <= 0 or (temperature > 0 and engine.canonical() < std::exp(-delta/temperature)))
+            move_to(candidate, cost);
+        if (not improves and _restart_after > 0 and ++_stalled_steps >= _restart_after) needs_restart = true;
+        return improves;
+    }
+
+    RandomEngine engine;
+    double temperature_factor;
+    std::optional<ConfigurationSearchPoint> current;
+    double current_cost = std::numeric_limits<double>::infinity();
+    double best_cost = std::numeric_limits<double>::infinity();
+    //! \brief Whether the chain has stalled or has no neighbour to draw, and should start again elsewhere
+    bool needs_restart = false;
+
+  private:
+    size_t _tabu_tenure;
+    size_t _restart_after;
+    size_t _stalled_steps = 0;
+    //! \brief The hashes of the points most recently moved to, oldest first, also indexed for lookup
+    std::deque<size_t> _tabu;
+    std::unordered_multiset<size_t> _tabu_hashes;
+};
+
+struct Incumbent {
+    std::mutex mutex;
+    std::optional<ConfigurationSearchPoint> point;
+    double cost = std::numeric_limits<double>::infinity();
+};
+
+//! \brief The maximum number of points drawn by a chain when asked for a point
+constexpr size_t MAXIMUM_DRAW_ATTEMPTS = 16;
+
+class LocalSearchAskTell : public ConfigurationSearchAskTellOptimiser {
+    //! \brief A chain with at most one point pending
+    struct PendingChain : Chain {
+        PendingChain(RandomEngine const& e, size_t tabu_tenure, size_t restart_after) : Chain(e, 1.0, tabu_tenure, restart_after) { }
+        std::optional<ConfigurationSearchPoint> pending;
+        //! \brief Whether the pending point is a start or restart, to be moved to regardless of its cost
+        bool is_starting = false;
+        size_t num_steps = 0;
+    };
+  public:
+    LocalSearchAskTell(ConfigurationSearchSpace const& space, size_t budget, std::shared_ptr<const ConfigurationSearchAcceptanceInterface> acceptance,
+                       size_t num_chains, size_t tabu_tenure, size_t restart_after, RandomEngine& engine)
+        : ConfigurationSearchAskTellOptimiser(space, budget), _acceptance(std::move(acceptance)) {
+        for (size_t k=0; k<num_chains; ++k) _chains.emplace_back(engine.split(), tabu_tenure, restart_after);
+    }
+
+  protected:
+    List<ConfigurationSearchPoint> propose(size_t amount) override {
+        List<ConfigurationSearchPoint> result;
+        for (auto& chain : _chains) {
+            if (result.size() == amount) break;
+            if (chain.pending.has_value()) continue;
+            chain.pending = _next_point(chain);
+            if (chain.pending.has_value()) result.push_back(*chain.pending);
+        }
+        return result;
+    }
+
+    void observe(ConfigurationSearchPoint const& point, double cost) override {
+        for (auto& chain : _chains) {
+            if (chain.pending != point) continue;
+            chain.pending.reset();
+            if (chain.is_starting) {
+                chain.is_starting = false;
+                chain.restart_from(point, cost);
+            } else _step(chain, point, cost);
+            return;
+        }
+    }
+
+  private:
+    //! \brief Whether \a point can be asked, i.e., it has not been asked and is not pending for another chain
+    bool _is_available(ConfigurationSearchPoint const& point) const {
+        if (is_asked(point)) return false;
+        for (auto const& chain : _chains) if (chain.pending == point) return false;
+        return true;
+    }
+
+    //! \brief The next point to ask for \a chain, after taking the steps whose costs are already known
+    std::optional<ConfigurationSearchPoint> _next_point(PendingChain& chain) {
+        for (size_t attempt=0; attempt<MAXIMUM_DRAW_ATTEMPTS; ++attempt) {
+            if (not chain.current.has_value() or chain.needs_restart) {
+                if (chain.current.has_value() and has_best() and best_cost() < chain.current_cost) {
+                    chain.restart_from(best(), best_cost());
+                } else {
+                    auto point = space().initial_point(chain.engine);
+                    if (auto known = told_cost(point)) chain.restart_from(point, *known);
+                    else if (_is_available(point)) { chain.is_starting = true; return point; }
+                    continue;
+                }
+            }
+            auto candidate = chain.draw();
+            if (not candidate.has_value()) { chain.needs_restart = true; continue; }
+            if (auto known = told_cost(*candidate)) _step(chain, *candidate, *known);
+            else if (_is_available(*candidate)) return candidate;
+        }
+        // All the draws hit points already asked: force a restart from a point never asked, so that the search is
+        // exhausted only when the space is
+        auto point = _unasked_point(chain.engine);
+        if (point.has_value()) chain.is_starting = true;
+        return point;
+    }
+
+    //! \brief A feasible point that can be asked, drawn at random or else the first by index
+    std::optional<ConfigurationSearchPoint> _unasked_point(RandomEngine& engine) {
+        for (size_t attempt=0; attempt<MAXIMUM_DRAW_ATTEMPTS; ++attempt) {
+            auto point = space().initial_point(engine);
+            if (_is_available(point)) return point;
+        }
+        // The points before the scan index are never available again, since points asked remain so
+        for (; _scan_index < space().total_points(); ++_scan_index) {
+            auto point = space().point_at(_scan_index);
+            if (space().is_feasible(point) and _is_available(point)) return point;
+        }
+        return std::nullopt;
+    }
+
+    void _step(PendingChain& chain, ConfigurationSearchPoint const& candidate, double cost) {
+        chain.step(candidate, cost, _acceptance->temperature(chain.num_steps++));
+    }
+
+    std::shared_ptr<const ConfigurationSearchAcceptanceInterface> _acceptance;
+    List<PendingChain> _chains;
+    //! \brief The index of the first point that may be available
+    uint64_t _scan_index = 0;
+};
+
+} // namespace
+
+ConfigurationSearchLocalSearch::ConfigurationSearchLocalSearch(ConfigurationSearchAcceptanceInterface const& acceptance, size_t num_steps)
+    : _acceptance(acceptance.clone()), _num_steps(num_steps), _num_chains(1), _tabu_tenure(0), _restart_after(0),
+      _tempering_ratio(1.0), _exchange_interval(0) { }
+
+void ConfigurationSearchLocalSearch::set_num_chains(size_t num_chains) {
+    HELPER_PRECONDITION(num_chains > 0)
+    _num_chains = num_chains;
+}
+
+void ConfigurationSearchLocalSearch::set_tabu_tenure(size_t tenure) {
+    _tabu_tenure = tenure;
+}
+
+void ConfigurationSearchLocalSearch::set_restart_after(size_t num_steps) {
+    _restart_after = num_steps;
+}
+
+void ConfigurationSearchLocalSearch::set_tempering(double ratio, size_t exchange_interval) {
+    HELPER_PRECONDITION(ratio > 1)
+    HELPER_PRECONDITION(exchange_interval > 0)
+    _tempering_ratio = ratio;
+    _exchange_interval = exchange_interval;
+}
+
+void ConfigurationSearchLocalSearch::set_cache(std::shared_ptr<ConfigurationSearchEvaluationCache> cache) {
+    _cache = std::move(cache);
+}
+
+size_t ConfigurationSearchLocalSearch::num_steps() const {
+    return _num_steps;
+}
+
+size_t ConfigurationSearchLocalSearch::num_chains() const {
+    return _num_chains;
+}
+
+ConfigurationSearchLocalSearchResult ConfigurationSearchLocalSearch::search(ConfigurationSearchSpace const& space, Cost const& cost,
+                                                                            RandomEngine& engine, CancellationToken const& cancellation) const {
+    bool const is_tempering = (_exchange_interval > 0);
+    HELPER_PRECONDITION(not is_tempering or _acceptance->temperature(0) > 0)
+
+    std::atomic<size_t> num_evaluations(0);
+    auto evaluate = [&](ConfigurationSearchPoint const& point) {
+        if (_cache != nullptr)
+            if (auto cached = _cache->find(point)) return *cached;
+        ++num_evaluations;
+        double const result = cost(point);
+        if (_cache != nullptr) _cache->insert(point, result);
+        return result;
+    };
+
+    Incumbent incumbent;
+    auto offer = [&](ConfigurationSearchPoint const& point, double point_cost) {
+        std::lock_guard<std::mutex> lock(incumbent.mutex);
+        // The first point is taken whatever its cost, and a NaN cost is replaced by any other
+        if (not incumbent.point.has_value() or point_cost < incumbent.cost or std::isnan(incumbent.cost)) {
+            incumbent.point = point;
+            incumbent.cost = point_cost;
+        }
+    };
+
+    List<Chain> chains;
+    chains.reserve(_num_chains);
+    for (size_t k=0; k<_num_chains; ++k) chains.emplace_back(engine.split(), std::pow(_tempering_ratio, static_cast<double>(k)), _tabu_tenure, _restart_after);
+    RandomEngine exchange_engine = engine.split();
+
+    // Restart from the incumbent if better than the current point, or else from a random point
+    auto restart = [&](Chain& chain) {
+        {
+            std::lock_guard<std::mutex> lock(incumbent.mutex);
+            if (incumbent.point.has_value() and incumbent.cost < chain.current_cost) {
+                chain.restart_from(*incumbent.point, incumbent.cost);
+                return;
+            }
+        }
+        auto point = space.initial_point(chain.engine);
+        double const point_cost = evaluate(point);
+        if (chain.restart_from(point, point_cost)) offer(point, point_cost);
+    };
+
+    auto step = [&](Chain& chain, size_t step_index) {
+        auto candidate = chain.draw();
+        if (not candidate.has_value()) { restart(chain); return; }
+        double const candidate_cost = evaluate(*candidate);
+        if (chain.step(*candidate, candidate_cost, _acceptance->temperature(step_index)*chain.temperature_factor))
+            offer(*candidate, candidate_cost);
+        if (chain.needs_restart) restart(chain);
+    };
+
+    std::atomic<bool> failed(false);
+    bool stopping = false;
+    size_t num_exchanges = 0;
+    // Run by a single thread once all chains have reached an exchange
+    auto exchange = [&]() noexcept {
+        ++num_exchanges;
+        stopping = (cancellation.is_cancelled() or failed.load());
+        double const temperature = _acceptance->temperature(num_exchanges*_exchange_interval);
+        for (size_t k=num_exchanges%2; k+1<chains.size(); k+=2) {
+            auto& cold = chains[k];
+            auto& hot = chains[k+1];
+            double const log_probability = (cold.current_cost - hot.current_cost)*(1/(temperature*cold.temperature_factor) - 1/(temperature*hot.temperature_factor));
+            if (log_probability >= 0 or exchange_engine.canonical() < std::exp(log_probability)) {
+                std::swap(cold.current, hot.current);
+                std::swap(cold.current_cost, hot.current_cost);
+            }
+        }
+    };
+    std::barrier synchronisation(static_cast<std::ptrdiff_t>(chains.size()), exchange);
+
+    auto run = [&](Chain& chain) {
+        auto point = space.initial_point(chain.engine);
+        double const point_cost = evaluate(point);
+        chain.move_to(point, point_cost);
+        offer(point, point_cost);
+        for (size_t s=0; s<_num_steps; ++s) {
+            if (is_tempering and s > 0 and s%_exchange_interval == 0) {
+                synchronisation.arrive_and_wait();
+                if (stopping) return;
+            } else if (not is_tempering and (cancellation.is_cancelled() or failed.load())) return;
+            step(chain, s);
+        }
+    };
+
+    List<std::exception_ptr> errors(chains.size());
+    List<std::thread> threads;
+    for (size_t k=0; k<chains.size(); ++k) {
+        threads.emplace_back([&,k]() {
+            try { run(chains[k]); }
+            catch (...) {
+                errors[k] = std::current_exception();
+                failed.store(true);
+                // Leave the exchanges, so that the other chains do not wait for this one
+                if (is_tempering) synchronisation.arrive_and_drop();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (auto const& error : errors) if (error != nullptr) std::rethrow_exception(error);
+
+    List<double> chain_best_costs;
+    for (auto const& chain : chains) chain_best_costs.push_back(chain.best_cost);
+    return {*incumbent.point, incumbent.cost, chain_best_costs, num_evaluations.load()};
+}
+
+std::shared_ptr<ConfigurationSearchAskTellOptimiser> ConfigurationSearchLocalSearch::make_ask_tell(ConfigurationSearchSpace const& space, size_t budget, RandomEngine& engine) const {
+    HELPER_PRECONDITION(_exchange_interval == 0)
+    return std::make_shared<LocalSearchAskTell>(space, budget, _acceptance, _num_chains, _tabu_tenure, _restart_after, engine);
+}
+
+} // namespace ProNest
@@ -26,15 +26,22 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-#include "helper/randomiser.hpp"
 #include "configuration_search_parameter.hpp"
 
 namespace ProNest {
 
-using Helper::UniformIntRandomiser;
+namespace {
+
+bool are_consecutive(List<int> const& values) {
+    for (size_t i=1; i<values.size(); ++i)
+        if (values[i] != values[i-1]+1) return false;
+    return true;
+}
+
+} // namespace
 
 ConfigurationSearchParameter::ConfigurationSearchParameter(ConfigurationPropertyPath const& path, bool is_metric, List<int> const& values) :
-    _path(path), _is_metric(is_metric), _values(values) {
+    _path(path), _is_metric(is_metric), _values(values), _has_consecutive_values(are_consecutive(values)) {
     HELPER_PRECONDITION(values.size()>1);
 }
 
@@ -46,31 +53,34 @@ List<int> const& ConfigurationSearchParameter::values() const {
     return _values;
 }
 
+size_t ConfigurationSearchParameter::index_of(int value) const {
+    if (_has_consecutive_values) {
+        HELPER_ASSERT_MSG(value >= _values.front() and value <= _values.back(),"Value " << value << " is not admissible for parameter '" << _path << "'.");
+        return static_cast<size_t>(value - _values.front());
+    }
+    for (size_t i=0; i<_values.size(); ++i) if (_values[i] == value) return i;
+    HELPER_FAIL_MSG("Value " << value << " is not admissible for parameter '" << _path << "'.");
+}
+
 bool ConfigurationSearchParameter::is_metric() const {
     return _is_metric;
 }
 
-int ConfigurationSearchParameter::random_value() const {
-    return _values[UniformIntRandomiser<size_t>(0,_values.size()-1).get()];
+int ConfigurationSearchParameter::random_value(RandomEngine& engine) const {
+    return _values[engine.uniform<size_t>(0,_values.size()-1)];
 }
 
-int ConfigurationSearchParameter::shifted_value_from(int value) const {
+int ConfigurationSearchParameter::shifted_value_from(int value, RandomEngine& engine) const {
     size_t num_values = _values.size();
     if (_is_metric) {
         if (value == _values[0]) return value+1;
         if (value == _values[num_values-1]) return value-1;
-        if (UniformIntRandomiser<size_t>(0,1).get() == 0) return value+1;
+        if (engine.uniform<size_t>(0,1) == 0) return value+1;
         else return value-1;
-    } else {
-        int result = 0;
-        while (true) {
-            size_t rand_value = UniformIntRandomiser<size_t>(0,num_values-1).get();
-            if (_values[rand_value] != value) {
-                result = _values[rand_value];
-                break;
-            }
-        }
-        return result;
+    } else { // Draws among the other values, skipping the current one
+        size_t index = engine.uniform<size_t>(0,num_values-2);
+        if (index >= index_of(value)) ++index;
+        return _values[index];
     }
 }
 
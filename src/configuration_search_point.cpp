@@ -26,127 +26,181 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
 #include "configuration_search_point.hpp"
 #include "configuration_search_space.hpp"
-#include "helper/randomiser.hpp"
+#include "configuration_search_point_set.hpp"
 
 namespace ProNest {
 
-using Helper::UniformIntRandomiser;
+namespace {
 
-ConfigurationSearchPoint::ConfigurationSearchPoint(ConfigurationSearchSpace const& space, ParameterBindingsMap const& bindings)
-    : _space(space.clone()), _bindings(bindings) { }
+//! \brief Sampler of indices without replacement from a range, using a sparse Fisher-Yates shuffle
+class IndexSampler {
+  public:
+    IndexSampler(uint64_t begin, uint64_t end) : _begin(begin), _remaining(end-begin) { }
 
-ConfigurationSearchPoint::ConfigurationSearchPoint(ConfigurationSearchPoint const& p) {
-    this->_bindings.clear();
-    this->_bindings.adjoin(p._bindings);
-    this->_CACHED_SHIFT_BREADTHS = p._CACHED_SHIFT_BREADTHS;
-    this->_space.reset(p.space().clone());
+    bool empty() const { return _remaining == 0; }
+
+    uint64_t next(RandomEngine& engine) {
+        uint64_t const drawn = engine.uniform<uint64_t>(0,_remaining-1);
+        uint64_t const last = _remaining-1;
+        uint64_t const result = _value_at(drawn);
+        _swapped[drawn] = _value_at(last);
+        _swapped.erase(last);
+        --_remaining;
+        return _begin + result;
+    }
+
+  private:
+    uint64_t _value_at(uint64_t position) const {
+        auto iter = _swapped.find(position);
+        return (iter == _swapped.end() ? position : iter->second);
+    }
+
+  private:
+    uint64_t const _begin;
+    uint64_t _remaining;
+    std::unordered_map<uint64_t,uint64_t> _swapped;
+};
+
+//! \brief A set of points for concurrent insertion, sharded by hash
+class ConcurrentPointSet {
+    static constexpr size_t NUM_SHARDS = 64;
+    struct Shard {
+        std::mutex mutex;
+        ConfigurationSearchPointSet points;
+    };
+  public:
+    ConcurrentPointSet(Set<ConfigurationSearchPoint> const& points) {
+        for (auto const& p : points) insert(p);
+    }
+
+    //! \brief Add the \a point if not present, returning whether it has been added
+    bool insert(ConfigurationSearchPoint const& point) {
+        auto& shard = _shards[point.hash() % NUM_SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.points.insert(point);
+    }
+
+  private:
+    std::array<Shard,NUM_SHARDS> _shards;
+};
+
+} // namespace
+
+ConfigurationSearchPoint::ConfigurationSearchPoint(ConfigurationSearchSpace const& space, List<int> const& coordinates)
+    : _space(space), _coordinates(coordinates) {
+    HELPER_PRECONDITION(coordinates.size() == space.dimension());
 }
 
-Set<ConfigurationSearchPoint> ConfigurationSearchPoint::make_random_shifted(size_t amount) const {
-    Set<ConfigurationSearchPoint> result;
-    ConfigurationSearchPoint current_point = *this;
-    result.insert(current_point);
+Set<ConfigurationSearchPoint> ConfigurationSearchPoint::make_random_shifted(size_t amount, RandomEngine& engine) const {
+    HELPER_PRECONDITION(amount <= _space.total_points());
+    // The points of the walk might not reach the amount, hence the search must be able to fail
+    if (not _space.constraints().empty()) return make_extended_set_by_shifting({*this}, amount, engine);
+    ConfigurationSearchPointSet result;
+    result.insert(*this);
+    size_t current_position = 0;
     while (result.size() < amount) {
-        List<unsigned int> breadths = current_point.shift_breadths();
-        unsigned int total_breadth = 0; for (auto const& b : breadths) total_breadth += b;
-        auto space = this->space();
-
-        unsigned int offset = UniformIntRandomiser<unsigned int>(0,total_breadth-1).get();
-        unsigned int current_breadth = 0;
-        ParameterBindingsMap shifted_bindings;
-        bool shifted = false;
-        for (auto const& binding : current_point.bindings()) {
-            auto const& param = current_point.parameter(binding.first);
-            int value = binding.second;
-            current_breadth += breadths.at(space.index(param));
-            if (not shifted and current_breadth > offset) {
-                value = param.shifted_value_from(value);
-                shifted = true;
-            }
-            shifted_bindings.insert(std::pair<ConfigurationPropertyPath,int>(param.path(), value));
-        }
-        result.insert(space.make_point(shifted_bindings));
+        result.insert(result[current_position].make_adjacent_shifted(engine));
+        current_position = engine.uniform<size_t>(0,result.size()-1);
+    }
+    return result.to_set();
+}
 
-        size_t new_choice = UniformIntRandomiser<size_t>(0,result.size()-1).get();
-        auto iter = result.begin();
-        for (size_t i=0; i<new_choice; ++i) ++iter;
-        current_point = *iter;
+ConfigurationSearchPoint ConfigurationSearchPoint::make_adjacent_shifted(RandomEngine& engine) const {
+    auto const num_adjacent = num_adjacent_points();
+    HELPER_PRECONDITION(num_adjacent != 0);
+    if (_space.constraints().empty()) return make_adjacent(engine.uniform<size_t>(0,num_adjacent-1));
+    IndexSampler sampler(0,num_adjacent);
+    while (not sampler.empty()) {
+        auto point = make_adjacent(static_cast<size_t>(sampler.next(engine)));
+        if (_space.is_feasible(point)) return point;
     }
+    HELPER_FAIL_MSG("No feasible point is adjacent to " << *this << ".");
+}
+
+size_t ConfigurationSearchPoint::num_adjacent_points() const {
+    size_t result = 0;
+    for (auto const& b : shift_breadths()) result += b;
     return result;
 }
 
-ConfigurationSearchPoint ConfigurationSearchPoint::make_adjacent_shifted() const {
-    List<unsigned int> breadths = this->shift_breadths();
-    unsigned int total_breadth = 0;
-    for (auto const& b : breadths) total_breadth += b;
-    HELPER_PRECONDITION(total_breadth != 0);
-    Set<ConfigurationSearchPoint> result;
-    auto space = this->space();
-
-    unsigned int offset = UniformIntRandomiser<unsigned int>(0,total_breadth-1).get();
-
-    unsigned int current_breadth = 0;
-    ParameterBindingsMap shifted_bindings;
-    bool shifted = false;
-    for (auto const& binding : _bindings) {
-        auto const &param = parameter(binding.first);
-        int value = binding.second;
-        current_breadth += breadths.at(space.index(param));
-        if (not shifted and current_breadth > offset) {
-            value = param.shifted_value_from(value);
-            shifted = true;
+ConfigurationSearchPoint ConfigurationSearchPoint::make_adjacent(size_t index) const {
+    auto const& parameters = _space.parameters();
+    for (size_t i=0; i<_coordinates.size(); ++i) {
+        auto const& param = parameters[i];
+        auto const& values = param.values();
+        auto const value = _coordinates[i];
+        size_t breadth;
+        if (not param.is_metric()) breadth = values.size()-1;
+        else if (value == values.front() or value == values.back()) breadth = 1;
+        else breadth = 2;
+
+        if (index < breadth) {
+            List<int> shifted_coordinates = _coordinates;
+            if (not param.is_metric()) { // All values except the current one, in order
+                size_t value_index = index;
+                if (value_index >= param.index_of(value)) ++value_index;
+                shifted_coordinates[i] = values[value_index];
+            } else if (value == values.front()) shifted_coordinates[i] = value+1;
+            else if (value == values.back()) shifted_coordinates[i] = value-1;
+            else shifted_coordinates[i] = (index == 0 ? value-1 : value+1);
+            return {_space, shifted_coordinates};
         }
-        shifted_bindings.insert(std::pair<ConfigurationPropertyPath, int>(param.path(), value));
+        index -= breadth;
     }
-    return space.make_point(shifted_bindings);
+    HELPER_FAIL_MSG("The adjacent point index exceeds the number of adjacent points.");
+}
+
+ConfigurationSearchPointNeighbours ConfigurationSearchPoint::neighbours() const {
+    return {*this};
 }
 
 ConfigurationSearchSpace const& ConfigurationSearchPoint::space() const {
-    return *_space;
+    return _space;
 }
 
-List<int> ConfigurationSearchPoint::coordinates() const {
-    return _bindings.values();
+List<int> const& ConfigurationSearchPoint::coordinates() const {
+    return _coordinates;
 }
 
-ParameterBindingsMap const& ConfigurationSearchPoint::bindings() const {
-    return _bindings;
+ParameterBindingsMap ConfigurationSearchPoint::bindings() const {
+    ParameterBindingsMap result;
+    auto const& parameters = _space.parameters();
+    for (size_t i=0; i<_coordinates.size(); ++i)
+        result.insert(std::pair<ConfigurationPropertyPath,int>(parameters[i].path(), _coordinates[i]));
+    return result;
 }
 
 int ConfigurationSearchPoint::value(ConfigurationPropertyPath const& path) const {
-    return _bindings.at(path);
+    return _coordinates[_space.index(path)];
 }
 
-size_t ConfigurationSearchPoint::index(ConfigurationPropertyPath const& path) const {
-    return _space->index(path);
+int ConfigurationSearchPoint::value(size_t idx) const {
+    return _coordinates.at(idx);
 }
 
-ConfigurationSearchParameter const& ConfigurationSearchPoint::parameter(ConfigurationPropertyPath const& path) const {
-    return _space->parameter(path);
+size_t ConfigurationSearchPoint::index(ConfigurationPropertyPath const& path) const {
+    return _space.index(path);
 }
 
-ConfigurationSearchPoint& ConfigurationSearchPoint::operator=(ConfigurationSearchPoint const& p) {
-    this->_bindings.clear();
-    this->_bindings.adjoin(p._bindings);
-    this->_CACHED_SHIFT_BREADTHS = p._CACHED_SHIFT_BREADTHS;
-    this->_space.reset(p.space().clone());
-    return *this;
+ConfigurationSearchParameter const& ConfigurationSearchPoint::parameter(ConfigurationPropertyPath const& path) const {
+    return _space.parameter(path);
 }
 
 bool ConfigurationSearchPoint::operator==(ConfigurationSearchPoint const& p) const {
-    for (auto const& b : _bindings)
-        if (p._bindings.at(b.first) != b.second)
-            return false;
-
-    return true;
+    return _coordinates == p._coordinates;
 }
 
 bool ConfigurationSearchPoint::operator<(ConfigurationSearchPoint const& p) const {
-    for (auto const& b : _bindings) {
-        auto const this_value = b.second;
-        auto const other_value = p._bindings.at(b.first);
+    for (size_t i=0; i<_coordinates.size(); ++i) {
+        auto const this_value = _coordinates[i];
+        auto const other_value = p._coordinates[i];
         if (this_value < other_value) return true;
         else if (this_value > other_value) return false;
     }
@@ -155,50 +209,159 @@ bool ConfigurationSearchPoint::operator<(ConfigurationSearchPoint const& p) cons
 
 unsigned int ConfigurationSearchPoint::distance(ConfigurationSearchPoint const& p) const {
     unsigned int result = 0;
-    for (auto const& b : _bindings) {
-        auto const& param = parameter(b.first);
-        auto const v1 = b.second;
-        auto const v2 = p._bindings.at(param.path());
-        if (param.is_metric()) result += (v1 > v2 ? (unsigned int)(v1 - v2) : (unsigned int)(v2 - v1));
+    auto const& parameters = _space.parameters();
+    for (size_t i=0; i<_coordinates.size(); ++i) {
+        auto const v1 = _coordinates[i];
+        auto const v2 = p._coordinates[i];
+        if (parameters[i].is_metric()) result += (v1 > v2 ? (unsigned int)(v1 - v2) : (unsigned int)(v2 - v1));
         else result += (v1 == v2 ? 0 : 1);
     }
     return result;
 }
 
+size_t ConfigurationSearchPoint::hash() const {
+    size_t result = _coordinates.size();
+    for (auto const& c : _coordinates)
+        result ^= std::hash<int>()(c) + 0x9e3779b97f4a7c15ULL + (result << 6) + (result >> 2);
+    return result;
+}
+
 ostream& operator<<(ostream& os, ConfigurationSearchPoint const& point) {
-    return os << point._bindings.values();
+    return os << point._coordinates;
 }
 
 List<unsigned int> ConfigurationSearchPoint::shift_breadths() const {
-    if (_CACHED_SHIFT_BREADTHS.empty()) {
-        for (auto const& b : _bindings) {
-            auto const& param = parameter(b.first);
-            auto const& values = param.values();
-            auto size = values.size();
-            if (not param.is_metric()) _CACHED_SHIFT_BREADTHS.push_back(static_cast<unsigned int>(size-1)); // all except the current
-            else if (b.second == values[size-1] or b.second == values[size-1]) _CACHED_SHIFT_BREADTHS.push_back(1); // can only move down or up
-            else _CACHED_SHIFT_BREADTHS.push_back(2); // can move either up or down
-        }
+    List<unsigned int> result;
+    result.reserve(_coordinates.size());
+    auto const& parameters = _space.parameters();
+    for (size_t i=0; i<_coordinates.size(); ++i) {
+        auto const& param = parameters[i];
+        auto const& values = param.values();
+        auto size = values.size();
+        auto const value = _coordinates[i];
+        if (not param.is_metric()) result.push_back(static_cast<unsigned int>(size-1)); // all except the current
+        else if (value == values[0] or value == values[size-1]) result.push_back(1); // can only move down or up
+        else result.push_back(2); // can move either up or down
+    }
+    return result;
+}
+
+ConfigurationSearchPointNeighbours::Iterator::Iterator(ConfigurationSearchPointNeighbours const& neighbours, size_t index)
+    : _neighbours(&neighbours), _index(index) { }
+
+ConfigurationSearchPoint ConfigurationSearchPointNeighbours::Iterator::operator*() const {
+    return (*_neighbours)[_index];
+}
+
+ConfigurationSearchPointNeighbours::Iterator& ConfigurationSearchPointNeighbours::Iterator::operator++() {
+    ++_index;
+    return *this;
+}
+
+ConfigurationSearchPointNeighbours::Iterator ConfigurationSearchPointNeighbours::Iterator::operator++(int) {
+    auto result = *this;
+    ++_index;
+    return result;
+}
+
+bool ConfigurationSearchPointNeighbours::Iterator::operator==(Iterator const& other) const {
+    return _neighbours == other._neighbours and _index == other._index;
+}
+
+bool ConfigurationSearchPointNeighbours::Iterator::operator!=(Iterator const& other) const {
+    return not (*this == other);
+}
+
+size_t ConfigurationSearchPointNeighbours::Iterator::index() const {
+    return _index;
+}
+
+ConfigurationSearchPointNeighbours::ConfigurationSearchPointNeighbours(ConfigurationSearchPoint const& centre)
+    : _centre(centre), _size(centre.num_adjacent_points()) {
+    auto const& space = centre.space();
+    if (not space.constraints().empty()) {
+        for (size_t i=0; i<_size; ++i)
+            if (space.is_feasible(centre.make_adjacent(i))) _feasible_indices.push_back(i);
+        _size = _feasible_indices.size();
     }
-    return _CACHED_SHIFT_BREADTHS;
 }
 
-Set<ConfigurationSearchPoint> make_extended_set_by_shifting(Set<ConfigurationSearchPoint> const& sources, size_t size) {
+ConfigurationSearchPoint const& ConfigurationSearchPointNeighbours::centre() const {
+    return _centre;
+}
+
+ConfigurationSearchPointNeighbours::Iterator ConfigurationSearchPointNeighbours::begin() const {
+    return {*this, 0};
+}
+
+ConfigurationSearchPointNeighbours::Iterator ConfigurationSearchPointNeighbours::end() const {
+    return {*this, _size};
+}
+
+size_t ConfigurationSearchPointNeighbours::size() const {
+    return _size;
+}
+
+bool ConfigurationSearchPointNeighbours::empty() const {
+    return _size == 0;
+}
+
+ConfigurationSearchPoint ConfigurationSearchPointNeighbours::operator[](size_t index) const {
+    HELPER_PRECONDITION(index < _size);
+    return _centre.make_adjacent(_centre.space().constraints().empty() ? index : _feasible_indices[index]);
+}
+
+Set<ConfigurationSearchPoint> make_extended_set_by_shifting(Set<ConfigurationSearchPoint> const& sources, size_t size, RandomEngine& engine, size_t concurrency) {
+    HELPER_PRECONDITION(concurrency > 0);
+    HELPER_PRECONDITION(not sources.empty());
     HELPER_PRECONDITION(size>=sources.size());
     HELPER_PRECONDITION(sources.begin()->space().total_points() >= size);
-    auto expanded_sources = sources; // To be expanded if the previous sources are incapable of getting the required size
+
+    auto const& space = sources.begin()->space();
+    ConcurrentPointSet visited(sources);
+    List<ConfigurationSearchPoint> frontier(sources.begin(),sources.end());
     auto result = sources;
 
     while (result.size() < size) {
-        auto source_it = expanded_sources.begin();
-        size_t previous_size = result.size();
-        while (result.size() < size) {
-            result.insert(source_it->make_adjacent_shifted());
-            ++source_it; // Will move to next source even if no shift has been found
-            if (source_it == expanded_sources.end()) break;
+        HELPER_ASSERT_MSG(not frontier.empty(),"No more points can be reached by shifting.");
+        List<uint64_t> offsets; // The first adjacent point index for each point of the frontier
+        offsets.reserve(frontier.size()+1);
+        offsets.push_back(0);
+        for (auto const& p : frontier) offsets.push_back(offsets.back() + p.num_adjacent_points());
+        uint64_t const total = offsets.back();
+        size_t const needed = size - result.size();
+        size_t const num_threads = static_cast<size_t>(std::max<uint64_t>(1,std::min<uint64_t>(concurrency,total)));
+
+        std::atomic<size_t> found(0);
+        List<List<ConfigurationSearchPoint>> new_points(num_threads);
+        List<RandomEngine> engines;
+        for (size_t t=0; t<num_threads; ++t) engines.push_back(engine.split());
+
+        auto draw = [&](size_t t) {
+            IndexSampler sampler(total*t/num_threads, total*(t+1)/num_threads);
+            while (not sampler.empty() and found.load() < needed) {
+                auto const index = sampler.next(engines[t]);
+                auto const source = static_cast<size_t>(std::upper_bound(offsets.begin(),offsets.end(),index) - offsets.begin()) - 1;
+                auto point = frontier[source].make_adjacent(static_cast<size_t>(index - offsets[source]));
+                if (visited.insert(point) and space.is_feasible(point)) {
+                    new_points[t].push_back(std::move(point));
+                    ++found;
+                }
+            }
+        };
+
+        run_concurrently(num_threads, concurrency, draw);
+
+        // If not enough points have been found, all the adjacent points have been visited and become the new frontier
+        List<ConfigurationSearchPoint> next_frontier;
+        for (auto& points : new_points) {
+            for (auto& p : points) {
+                if (result.size() == size) break;
+                result.insert(p);
+                next_frontier.push_back(std::move(p));
+            }
         }
-        // At the end of a cycle, if no increment of points has been obtained, add the current results to the sources
-        if (result.size() == previous_size) expanded_sources.adjoin(result);
+        frontier = std::move(next_frontier);
     }
     return result;
 }
@@ -0,0 +1,171 @@
+/***************************************************************************
+ *            configuration_search_point_range.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/macros.hpp"
+#include "configuration_search_point_range.hpp"
+
+namespace ProNest {
+
+ConfigurationSearchPointRange::Iterator::Iterator(ConfigurationSearchPointRange const& range, uint64_t rank)
+    : _range(&range), _rank(rank) {
+    if (rank < range._end) {
+        _digits = range._digits_of(rank);
+        _skip_infeasible();
+    }
+}
+
+ConfigurationSearchPoint ConfigurationSearchPointRange::Iterator::operator*() const {
+    HELPER_PRECONDITION(_rank < _range->_end);
+    return _range->_point_from(_digits);
+}
+
+ConfigurationSearchPointRange::Iterator& ConfigurationSearchPointRange::Iterator::operator++() {
+    _step();
+    _skip_infeasible();
+    return *this;
+}
+
+void ConfigurationSearchPointRange::Iterator::_step() {
+    ++_rank;
+    if (_rank < _range->_end) {
+        auto const& parameters = _range->_space.parameters();
+        for (size_t i=_digits.size(); i>0; --i) {
+            if (++_digits[i-1] < parameters[i-1].values().size()) break;
+            _digits[i-1] = 0;
+        }
+    }
+}
+
+void ConfigurationSearchPointRange::Iterator::_skip_infeasible() {
+    auto const& space = _range->_space;
+    if (space.constraints().empty()) return;
+    while (_rank < _range->_end and not space.is_feasible(_range->_point_from(_digits))) _step();
+}
+
+ConfigurationSearchPointRange::Iterator ConfigurationSearchPointRange::Iterator::operator++(int) {
+    auto result = *this;
+    ++(*this);
+    return result;
+}
+
+bool ConfigurationSearchPointRange::Iterator::operator==(Iterator const& other) const {
+    return _rank == other._rank;
+}
+
+bool ConfigurationSearchPointRange::Iterator::operator!=(Iterator const& other) const {
+    return _rank != other._rank;
+}
+
+uint64_t ConfigurationSearchPointRange::Iterator::rank() const {
+    return _rank;
+}
+
+ConfigurationSearchPointRange::ConfigurationSearchPointRange(ConfigurationSearchSpace const& space, ConfigurationSearchPointOrdering ordering)
+    : ConfigurationSearchPointRange(space, ordering, 0, space.total_points()) { }
+
+ConfigurationSearchPointRange::ConfigurationSearchPointRange(ConfigurationSearchSpace const& space, ConfigurationSearchPointOrdering ordering, uint64_t begin, uint64_t end)
+    : _space(space), _ordering(ordering), _begin(begin), _end(end) {
+    HELPER_PRECONDITION(begin <= end);
+    HELPER_PRECONDITION(end <= space.total_points());
+}
+
+ConfigurationSearchSpace const& ConfigurationSearchPointRange::space() const {
+    return _space;
+}
+
+ConfigurationSearchPointOrdering ConfigurationSearchPointRange::ordering() const {
+    return _ordering;
+}
+
+ConfigurationSearchPointRange::Iterator ConfigurationSearchPointRange::begin() const {
+    return {*this, _begin};
+}
+
+ConfigurationSearchPointRange::Iterator ConfigurationSearchPointRange::end() const {
+    return {*this, _end};
+}
+
+uint64_t ConfigurationSearchPointRange::size() const {
+    return _end - _begin;
+}
+
+bool ConfigurationSearchPointRange::empty() const {
+    return _begin == _end;
+}
+
+ConfigurationSearchPoint ConfigurationSearchPointRange::point_at(uint64_t rank) const {
+    HELPER_PRECONDITION(rank < _space.total_points());
+    return _point_from(_digits_of(rank));
+}
+
+ConfigurationSearchPointRange ConfigurationSearchPointRange::chunk(size_t i, size_t n) const {
+    HELPER_PRECONDITION(n > 0);
+    HELPER_PRECONDITION(i < n);
+    uint64_t const base = size()/n;
+    uint64_t const remainder = size()%n;
+    uint64_t const chunk_begin = _begin + base*i + std::min<uint64_t>(i, remainder);
+    uint64_t const chunk_end = chunk_begin + base + (i < remainder ? 1 : 0);
+    return {_space, _ordering, chunk_begin, chunk_end};
+}
+
+List<ConfigurationSearchPointRange> ConfigurationSearchPointRange::partition(size_t n) const {
+    List<ConfigurationSearchPointRange> result;
+    for (size_t i=0; i<n; ++i) result.push_back(chunk(i, n));
+    return result;
+}
+
+List<size_t> ConfigurationSearchPointRange::_digits_of(uint64_t rank) const {
+    auto const& parameters = _space.parameters();
+    List<size_t> result(parameters.size());
+    for (size_t i=parameters.size(); i>0; --i) {
+        auto const radix = parameters[i-1].values().size();
+        result[i-1] = static_cast<size_t>(rank % radix);
+        rank /= radix;
+    }
+    return result;
+}
+
+ConfigurationSearchPoint ConfigurationSearchPointRange::_point_from(List<size_t> const& digits) const {
+    auto const& parameters = _space.parameters();
+    List<int> coordinates;
+    coordinates.reserve(parameters.size());
+    if (_ordering == ConfigurationSearchPointOrdering::LEXICOGRAPHIC) {
+        for (size_t i=0; i<parameters.size(); ++i) coordinates.push_back(parameters[i].values()[digits[i]]);
+    } else {
+        // A digit is reflected if the rank of the more significant digits is odd
+        bool prefix_is_odd = false;
+        for (size_t i=0; i<parameters.size(); ++i) {
+            auto const& values = parameters[i].values();
+            coordinates.push_back(values[prefix_is_odd ? values.size()-1-digits[i] : digits[i]]);
+            prefix_is_odd = ((prefix_is_odd and values.size()%2 == 1) != (digits[i]%2 == 1));
+        }
+    }
+    return _space.make_point(coordinates);
+}
+
+} // namespace ProNest
@@ -0,0 +1,84 @@
+/***************************************************************************
+ *            configuration_search_point_set.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "configuration_search_point_set.hpp"
+
+namespace ProNest {
+
+ConfigurationSearchPointSet::ConfigurationSearchPointSet(Set<ConfigurationSearchPoint> const& points) {
+    _points.reserve(points.size());
+    for (auto const& p : points) insert(p);
+}
+
+bool ConfigurationSearchPointSet::insert(ConfigurationSearchPoint const& point) {
+    auto const hash = point.hash();
+    auto range = _positions.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+        if (_points[it->second] == point) return false;
+    _positions.emplace(hash,_points.size());
+    _points.push_back(point);
+    return true;
+}
+
+bool ConfigurationSearchPointSet::contains(ConfigurationSearchPoint const& point) const {
+    auto range = _positions.equal_range(point.hash());
+    for (auto it = range.first; it != range.second; ++it)
+        if (_points[it->second] == point) return true;
+    return false;
+}
+
+size_t ConfigurationSearchPointSet::size() const {
+    return _points.size();
+}
+
+bool ConfigurationSearchPointSet::empty() const {
+    return _points.empty();
+}
+
+ConfigurationSearchPoint const& ConfigurationSearchPointSet::operator[](size_t position) const {
+    HELPER_PRECONDITION(position < _points.size());
+    return _points[position];
+}
+
+List<ConfigurationSearchPoint> const& ConfigurationSearchPointSet::points() const {
+    return _points;
+}
+
+ConfigurationSearchPointSet::const_iterator ConfigurationSearchPointSet::begin() const {
+    return _points.begin();
+}
+
+ConfigurationSearchPointSet::const_iterator ConfigurationSearchPointSet::end() const {
+    return _points.end();
+}
+
+Set<ConfigurationSearchPoint> ConfigurationSearchPointSet::to_set() const {
+    return Set<ConfigurationSearchPoint>(_points.begin(),_points.end());
+}
+
+} // namespace ProNest
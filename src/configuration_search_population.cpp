@@ -0,0 +1,145 @@
+/***************************************************************************
+ *            configuration_search_population.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include "configuration_search_space.hpp"
+#include "configuration_search_population.hpp"
+
+namespace ProNest {
+
+ConfigurationSearchPopulation::ConfigurationSearchPopulation(List<ConfigurationSearchPoint> const& points)
+    : _space(points.empty() ? ConfigurationSearchSpace(Set<ConfigurationSearchParameter>()) : points.front().space()),
+      _size(points.size()) {
+    for (auto const& p : points) HELPER_PRECONDITION(p.space() == _space);
+    auto const dimension = _space.dimension();
+    _columns.resize(dimension);
+    for (size_t d=0; d<dimension; ++d) {
+        _is_metric.push_back(_space.parameters()[d].is_metric());
+        _columns[d].reserve(_size);
+        for (auto const& p : points) _columns[d].push_back(p.coordinates()[d]);
+    }
+}
+
+size_t ConfigurationSearchPopulation::size() const {
+    return _size;
+}
+
+ConfigurationSearchPoint ConfigurationSearchPopulation::point(size_t index) const {
+    HELPER_PRECONDITION(index < _size);
+    List<int> coordinates;
+    coordinates.reserve(_columns.size());
+    for (auto const& column : _columns) coordinates.push_back(column[index]);
+    return _space.make_point(coordinates);
+}
+
+void ConfigurationSearchPopulation::_accumulate_distances(size_t index, size_t first, unsigned int* result) const {
+    size_t const count = _size - first;
+    for (size_t d=0; d<_columns.size(); ++d) {
+        int const* values = _columns[d].data() + first;
+        int const reference = _columns[d][index];
+        if (_is_metric[d]) {
+            for (size_t j=0; j<count; ++j) {
+                int const difference = values[j] - reference;
+                result[j] += static_cast<unsigned int>(difference < 0 ? -difference : difference);
+            }
+        } else {
+            for (size_t j=0; j<count; ++j) result[j] += static_cast<unsigned int>(values[j] != reference);
+        }
+    }
+}
+
+List<unsigned int> ConfigurationSearchPopulation::distances_from(size_t index) const {
+    HELPER_PRECONDITION(index < _size);
+    List<unsigned int> result(_size,0);
+    _accumulate_distances(index,0,result.data());
+    return result;
+}
+
+List<unsigned int> ConfigurationSearchPopulation::distance_matrix() const {
+    List<unsigned int> result(_size*_size,0);
+    for (size_t i=0; i<_size; ++i) {
+        unsigned int* row = result.data() + i*_size;
+        if (i+1 < _size) _accumulate_distances(i,i+1,row+i+1);
+        for (size_t j=0; j<i; ++j) row[j] = result[j*_size+i];
+    }
+    return result;
+}
+
+List<List<unsigned int>> ConfigurationSearchPopulation::nearest_distances(size_t k) const {
+    HELPER_PRECONDITION(k < _size);
+    List<List<unsigned int>> result;
+    result.reserve(_size);
+    for (size_t i=0; i<_size; ++i) {
+        auto distances = distances_from(i);
+        distances.erase(distances.begin() + static_cast<std::ptrdiff_t>(i));
+        std::partial_sort(distances.begin(),distances.begin()+static_cast<std::ptrdiff_t>(k),distances.end());
+        distances.resize(k);
+        result.push_back(std::move(distances));
+    }
+    return result;
+}
+
+unsigned int ConfigurationSearchPopulation::maximum_distance() const {
+    unsigned int result = 0;
+    for (auto const& p : _space.parameters()) {
+        if (p.is_metric()) result += static_cast<unsigned int>(p.values().back() - p.values().front());
+        else result += 1;
+    }
+    return result;
+}
+
+double ConfigurationSearchPopulation::mean_distance() const {
+    if (_size < 2) return 0.0;
+    List<unsigned int> row(_size,0);
+    double total = 0.0;
+    for (size_t i=0; i+1<_size; ++i) {
+        std::fill(row.begin(),row.end(),0);
+        _accumulate_distances(i,i+1,row.data());
+        for (size_t j=0; j<_size-i-1; ++j) total += row[j];
+    }
+    return total/(static_cast<double>(_size)*static_cast<double>(_size-1)/2);
+}
+
+double ConfigurationSearchPopulation::diversity() const {
+    auto const maximum = maximum_distance();
+    return (maximum == 0 ? 0.0 : mean_distance()/maximum);
+}
+
+List<double> ConfigurationSearchPopulation::crowding(size_t k) const {
+    HELPER_PRECONDITION(k > 0);
+    List<double> result;
+    result.reserve(_size);
+    for (auto const& distances : nearest_distances(k)) {
+        double sum = 0.0;
+        for (auto const& d : distances) sum += d;
+        result.push_back(sum/static_cast<double>(k));
+    }
+    return result;
+}
+
+} // namespace ProNest
@@ -0,0 +1,372 @@
+/***************************************************************************
+ *            src/configuration_search_process_pool.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <poll.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <cerrno>
+#include <thread>
+#include <cstring>
+#include "configuration_search_process_pool.hpp"
+
+namespace ProNest {
+
+namespace {
+
+//! \brief The status byte of a response with a cost
+constexpr uint8_t STATUS_COST = 0;
+//! \brief The status byte of a response with the message of an exception thrown by the cost
+constexpr uint8_t STATUS_ERROR = 1;
+
+// Writing to a socket closed by a terminated worker must fail instead of raising SIGPIPE
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+//! \brief The descriptor of the socket of a worker process, after the standard streams
+constexpr int WORKER_SOCKET = 3;
+
+//! \brief The time given to workers for exiting after their socket is shut down, and then after SIGTERM, before SIGKILL
+constexpr auto STOP_GRACE_PERIOD = std::chrono::milliseconds(500);
+
+//! \brief Keep only the standard streams and \a socket, moved to WORKER_SOCKET, among the descriptors inherited by a worker
+//! \details Otherwise a worker would hold the coordinator ends of the sockets of other workers, including those of
+//! other pools, which then would not receive an end of stream when their coordinator closes them.
+void close_inherited_descriptors(int socket) {
+    if (socket != WORKER_SOCKET) {
+        ::dup2(socket, WORKER_SOCKET);
+        ::close(socket);
+    }
+#if defined(__GLIBC__) and (__GLIBC__ > 2 or (__GLIBC__ == 2 and __GLIBC_MINOR__ >= 34))
+    if (::close_range(WORKER_SOCKET+1, ~0U, 0) == 0) return;
+#endif
+    long const maximum = ::sysconf(_SC_OPEN_MAX);
+    for (int fd = WORKER_SOCKET+1; fd < (maximum > 0 ? maximum : 1024); ++fd) ::close(fd);
+}
+
+//! \brief Wait for the workers with \a pids to exit, sending SIGTERM and then SIGKILL to those still running after each grace period
+void reap(List<int> pids) {
+    auto const reap_exited = [&pids]() {
+        List<int> running;
+        for (auto pid : pids) if (::waitpid(pid, nullptr, WNOHANG) == 0) running.push_back(pid);
+        pids = std::move(running);
+    };
+    auto const wait_grace_period = [&]() {
+        auto const deadline = std::chrono::steady_clock::now() + STOP_GRACE_PERIOD;
+        for (reap_exited(); not pids.empty() and std::chrono::steady_clock::now() < deadline; reap_exited())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+    wait_grace_period();
+    for (auto pid : pids) ::kill(pid, SIGTERM);
+    wait_grace_period();
+    for (auto pid : pids) {
+        ::kill(pid, SIGKILL);
+        while (::waitpid(pid, nullptr, 0) < 0 and errno == EINTR) { }
+    }
+}
+
+void append_varint(List<uint8_t>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t read_varint(List<uint8_t> const& bytes, size_t& position) {
+    uint64_t result = 0;
+    for (unsigned int shift = 0; ; shift += 7) {
+        HELPER_ASSERT_MSG(position < bytes.size() and shift < 64,"Malformed variable-length integer.");
+        uint8_t const byte = bytes[position++];
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return result;
+    }
+}
+
+uint64_t zigzag(int value) {
+    auto const v = static_cast<int64_t>(value);
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int unzigzag(uint64_t value) {
+    return static_cast<int>(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1));
+}
+
+//! \brief Write all of \a size bytes, returning false if the peer has closed the socket
+bool write_all(int socket, uint8_t const* data, size_t size) {
+    while (size > 0) {
+        auto const written = ::send(socket, data, size, SEND_FLAGS);
+        if (written < 0 and errno == EINTR) continue;
+        if (written <= 0) return false;
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+//! \brief Read exactly \a size bytes, returning false on end of stream
+bool read_all(int socket, uint8_t* data, size_t size) {
+    while (size > 0) {
+        auto const received = ::recv(socket, data, size, 0);
+        if (received < 0 and errno == EINTR) continue;
+        if (received <= 0) return false;
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+//! \brief Write a frame made of the 4-byte length of the \a payload followed by the payload
+bool write_frame(int socket, List<uint8_t> const& payload) {
+    auto const length = static_cast<uint32_t>(payload.size());
+    List<uint8_t> frame(sizeof(length));
+    std::memcpy(frame.data(), &length, sizeof(length));
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return write_all(socket, frame.data(), frame.size());
+}
+
+bool read_frame(int socket, List<uint8_t>& payload) {
+    uint32_t length = 0;
+    if (not read_all(socket, reinterpret_cast<uint8_t*>(&length), sizeof(length))) return false;
+    payload.resize(length);
+    return read_all(socket, payload.data(), length);
+}
+
+//! \brief The loop of a worker process, evaluating the points received until the coordinator closes the socket
+//! \details Only exceptions from the cost are reported; others, e.g., from a malformed request, leave the loop.
+[[noreturn]] void serve(int socket, ConfigurationSearchSpace const& space, ConfigurationSearchProcessPool::Cost const& cost) {
+    List<uint8_t> request;
+    while (read_frame(socket, request)) {
+        size_t position = 0;
+        auto const index = read_varint(request, position);
+        auto const point = decode_point(space, List<uint8_t>(request.begin() + static_cast<std::ptrdiff_t>(position), request.end()));
+        std::optional<double> value;
+        String message;
+        try {
+            value = cost(point);
+        } catch (std::exception const& e) {
+            message = e.what();
+        } catch (...) {
+            message = "Unknown exception.";
+        }
+        List<uint8_t> response;
+        append_varint(response, index);
+        if (value.has_value()) {
+            response.push_back(STATUS_COST);
+            uint8_t bytes[sizeof(double)];
+            std::memcpy(bytes, &*value, sizeof(double));
+            response.insert(response.end(), bytes, bytes + sizeof(double));
+        } else {
+            response.push_back(STATUS_ERROR);
+            response.insert(response.end(), message.begin(), message.end());
+        }
+        if (not write_frame(socket, response)) break;
+    }
+    // Skip the destructors and exit handlers inherited from the coordinator
+    ::_exit(0);
+}
+
+} // namespace
+
+List<uint8_t> encode_point(ConfigurationSearchPoint const& point) {
+    List<uint8_t> result;
+    auto const& coordinates = point.coordinates();
+    append_varint(result, coordinates.size());
+    for (auto c : coordinates) append_varint(result, zigzag(c));
+    return result;
+}
+
+ConfigurationSearchPoint decode_point(ConfigurationSearchSpace const& space, List<uint8_t> const& bytes) {
+    size_t position = 0;
+    auto const size = read_varint(bytes, position);
+    HELPER_ASSERT_MSG(size == space.dimension(),"The encoded point has " << size << " coordinates, while the space has dimension " << space.dimension() << ".");
+    List<int> coordinates;
+    for (size_t i=0; i<size; ++i) coordinates.push_back(unzigzag(read_varint(bytes, position)));
+    HELPER_ASSERT_MSG(position == bytes.size(),"The encoded point has trailing bytes.");
+    return space.make_point(coordinates);
+}
+
+ConfigurationSearchProcessPool::ConfigurationSearchProcessPool(ConfigurationSearchSpace const& space, Cost const& cost, size_t num_workers)
+    : _space(space), _cost(cost), _pids(num_workers, -1), _sockets(num_workers, -1), _num_restarts(0) {
+    HELPER_PRECONDITION(num_workers > 0)
+    for (size_t w=0; w<num_workers; ++w) _spawn(w);
+}
+
+ConfigurationSearchProcessPool::~ConfigurationSearchProcessPool() {
+    // The workers are stopped together, so that the grace periods are not summed
+    List<int> pids;
+    for (size_t w=0; w<_pids.size(); ++w) {
+        if (_pids[w] > 0) pids.push_back(_pids[w]);
+        _close(w);
+    }
+    reap(pids);
+}
+
+size_t ConfigurationSearchProcessPool::num_workers() const {
+    return _pids.size();
+}
+
+size_t ConfigurationSearchProcessPool::num_restarts() const {
+    return _num_restarts;
+}
+
+void ConfigurationSearchProcessPool::_spawn(size_t worker) {
+    int sockets[2];
+    HELPER_ASSERT_MSG(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0,"Could not create a socket pair: " << std::strerror(errno));
+#ifdef SO_NOSIGPIPE
+    int const enabled = 1;
+    ::setsockopt(sockets[0], SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+    auto const pid = ::fork();
+    if (pid < 0) {
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+        HELPER_FAIL_MSG("Could not fork a worker process: " << std::strerror(errno));
+    }
+    if (pid == 0) {
+        // The child must never return from here, or it would carry on as a second coordinator
+        try {
+            ::close(sockets[0]);
+            close_inherited_descriptors(sockets[1]);
+            serve(WORKER_SOCKET, _space, _cost);
+        } catch (...) {
+            ::_exit(1);
+        }
+    }
+    ::close(sockets[1]);
+    _pids[worker] = pid;
+    _sockets[worker] = sockets[0];
+}
+
+void ConfigurationSearchProcessPool::_close(size_t worker) {
+    // Shutting down delivers the end of stream to the worker even if another process still holds the descriptor
+    if (_sockets[worker] >= 0) {
+        ::shutdown(_sockets[worker], SHUT_RDWR);
+        ::close(_sockets[worker]);
+    }
+    _sockets[worker] = -1;
+}
+
+void ConfigurationSearchProcessPool::_stop(size_t worker) {
+    _close(worker);
+    if (_pids[worker] > 0) reap({_pids[worker]});
+    _pids[worker] = -1;
+}
+
+List<ConfigurationSearchProcessEvaluation> ConfigurationSearchProcessPool::evaluate(List<ConfigurationSearchPoint> const& points, Callback const& on_result,
+                                                                                  CancellationToken const& cancellation) {
+    using Clock = std::chrono::steady_clock;
+    struct Assignment {
+        size_t index;
+        Clock::time_point start;
+    };
+
+    List<std::optional<ConfigurationSearchProcessEvaluation>> evaluations(points.size());
+    List<std::optional<Assignment>> assignments(_pids.size());
+    size_t next = 0;
+
+    auto record = [&](size_t index, std::optional<double> cost, String const& error, bool is_crashed, Clock::time_point start) {
+        evaluations[index].emplace(ConfigurationSearchProcessEvaluation{points[index], cost, error, is_crashed, Clock::now() - start});
+        if (on_result) on_result(*evaluations[index]);
+    };
+
+    auto replace = [&](size_t worker) {
+        _stop(worker);
+        _spawn(worker);
+        ++_num_restarts;
+    };
+
+    auto assign = [&](size_t worker) {
+        while (next < points.size() and not cancellation.is_cancelled()) {
+            List<uint8_t> request;
+            append_varint(request, next);
+            auto const encoded = encode_point(points[next]);
+            request.insert(request.end(), encoded.begin(), encoded.end());
+            if (write_frame(_sockets[worker], request)) {
+                assignments[worker] = Assignment{next++, Clock::now()};
+                return;
+            }
+            // The worker terminated while idle, hence the point can be sent to its replacement
+            replace(worker);
+        }
+    };
+
+    for (size_t w=0; w<_pids.size(); ++w) assign(w);
+
+    while (true) {
+        List<pollfd> descriptors;
+        List<size_t> workers;
+        for (size_t w=0; w<assignments.size(); ++w) {
+            if (not assignments[w].has_value()) continue;
+            descriptors.push_back(pollfd{_sockets[w], POLLIN, 0});
+            workers.push_back(w);
+        }
+        if (descriptors.empty()) break;
+        if (::poll(descriptors.data(), descriptors.size(), -1) < 0) {
+            HELPER_ASSERT_MSG(errno == EINTR,"Could not poll the worker sockets: " << std::strerror(errno));
+            continue;
+        }
+        for (size_t i=0; i<descriptors.size(); ++i) {
+            if (descriptors[i].revents == 0) continue;
+            size_t const w = workers[i];
+            auto const assignment = *assignments[w];
+            assignments[w].reset();
+            List<uint8_t> response;
+            if (not read_frame(_sockets[w], response)) {
+                replace(w);
+                record(assignment.index, std::nullopt, "The worker process terminated during the evaluation.", true, assignment.start);
+            } else {
+                size_t position = 0;
+                auto const index = read_varint(response, position);
+                HELPER_ASSERT_MSG(index == assignment.index,"The worker responded for point " << index << " instead of " << assignment.index << ".");
+                HELPER_ASSERT_MSG(position < response.size(),"The worker response has no status.");
+                uint8_t const status = response[position++];
+                if (status == STATUS_COST) {
+                    HELPER_ASSERT_MSG(response.size() == position + sizeof(double),"The worker response has a malformed cost.");
+                    double cost;
+                    std::memcpy(&cost, response.data() + position, sizeof(double));
+                    record(assignment.index, cost, String(), false, assignment.start);
+                } else {
+                    record(assignment.index, std::nullopt, String(response.begin() + static_cast<std::ptrdiff_t>(position), response.end()), false, assignment.start);
+                }
+            }
+            assign(w);
+        }
+    }
+
+    List<ConfigurationSearchProcessEvaluation> result;
+    for (auto& evaluation : evaluations)
+        if (evaluation.has_value()) result.push_back(std::move(*evaluation));
+    return result;
+}
+
+} // namespace ProNest
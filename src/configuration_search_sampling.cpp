@@ -0,0 +1,178 @@
+/***************************************************************************
+ *            configuration_search_sampling.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <array>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include "configuration_search_sampling.hpp"
+#include "configuration_search_point_set.hpp"
+
+namespace ProNest {
+
+namespace {
+
+//! \brief The degree, polynomial coefficients and initial direction numbers for Sobol dimensions after the first
+//! \details From the Joe-Kuo tables; the initial numbers are odd and the k-th is lower than 2^k
+struct SobolDirection { unsigned int degree; unsigned int coefficients; std::array<uint32_t,7> initial; };
+
+const std::array<SobolDirection,SOBOL_MAXIMUM_DIMENSION-1> sobol_directions = {{
+    {1,0,{1}}, {2,1,{1,3}}, {3,1,{1,3,1}}, {3,2,{1,1,1}}, {4,1,{1,1,3,3}}, {4,4,{1,3,5,13}},
+    {5,2,{1,1,5,5,17}}, {5,4,{1,1,5,5,5}}, {5,7,{1,1,7,11,19}}, {5,11,{1,1,5,1,1}}, {5,13,{1,1,1,3,11}},
+    {5,14,{1,3,5,5,31}}, {6,1,{1,3,3,9,7,49}}, {6,13,{1,1,1,15,21,21}}, {6,16,{1,3,1,13,27,49}},
+    {6,19,{1,1,1,15,7,5}}, {6,22,{1,3,1,15,13,25}}, {6,25,{1,1,5,5,19,61}}, {7,1,{1,3,7,11,23,15,103}},
+    {7,4,{1,3,7,13,13,15,69}}
+}};
+
+constexpr unsigned int SOBOL_BITS = 32;
+
+//! \brief The direction numbers of a Sobol dimension, scaled to SOBOL_BITS bits
+std::array<uint32_t,SOBOL_BITS> sobol_direction_numbers(size_t dimension) {
+    std::array<uint32_t,SOBOL_BITS> result;
+    if (dimension == 0) {
+        for (unsigned int k=0; k<SOBOL_BITS; ++k) result[k] = uint32_t(1) << (SOBOL_BITS-1-k);
+        return result;
+    }
+    auto const& d = sobol_directions[dimension-1];
+    for (unsigned int k=0; k<d.degree; ++k) result[k] = d.initial[k] << (SOBOL_BITS-1-k);
+    for (unsigned int k=d.degree; k<SOBOL_BITS; ++k) {
+        uint32_t v = result[k-d.degree] ^ (result[k-d.degree] >> d.degree);
+        for (unsigned int j=1; j<d.degree; ++j)
+            if ((d.coefficients >> (d.degree-1-j)) & 1) v ^= result[k-j];
+        result[k] = v;
+    }
+    return result;
+}
+
+List<unsigned int> first_primes(size_t amount) {
+    List<unsigned int> result;
+    for (unsigned int n=2; result.size()<amount; ++n) {
+        bool is_prime = true;
+        for (auto p : result) {
+            if (p*p > n) break;
+            if (n % p == 0) { is_prime = false; break; }
+        }
+        if (is_prime) result.push_back(n);
+    }
+    return result;
+}
+
+//! \brief The radical inverse of \a index in the given \a base, i.e., its digits mirrored around the radix point
+double radical_inverse(uint64_t index, unsigned int base) {
+    double const inverse_base = 1.0/base;
+    double result = 0.0, factor = inverse_base;
+    for (; index > 0; index /= base, factor *= inverse_base) result += static_cast<double>(index % base)*factor;
+    return result;
+}
+
+//! \brief The design coordinates in [0,1), as one row of length \a dimension for each of the \a amount points
+List<List<double>> design_coordinates(size_t dimension, size_t amount, ConfigurationSearchSampling sampling, RandomEngine& engine) {
+    List<List<double>> result(amount, List<double>(dimension));
+    switch (sampling) {
+        case ConfigurationSearchSampling::UNIFORM:
+            for (auto& row : result) for (auto& u : row) u = engine.canonical();
+            break;
+        case ConfigurationSearchSampling::LATIN_HYPERCUBE: {
+            List<size_t> strata(amount);
+            for (size_t j=0; j<dimension; ++j) {
+                std::iota(strata.begin(),strata.end(),0);
+                std::shuffle(strata.begin(),strata.end(),engine);
+                for (size_t i=0; i<amount; ++i)
+                    result[i][j] = (static_cast<double>(strata[i]) + engine.canonical())/static_cast<double>(amount);
+            }
+            break;
+        }
+        case ConfigurationSearchSampling::HALTON: {
+            auto primes = first_primes(dimension);
+            for (size_t j=0; j<dimension; ++j) {
+                double const shift = engine.canonical();
+                for (size_t i=0; i<amount; ++i) {
+                    double u = radical_inverse(i+1,primes[j]) + shift;
+                    result[i][j] = (u >= 1.0 ? u - 1.0 : u);
+                }
+            }
+            break;
+        }
+        case ConfigurationSearchSampling::SOBOL: {
+            HELPER_PRECONDITION(dimension <= SOBOL_MAXIMUM_DIMENSION)
+            for (size_t j=0; j<dimension; ++j) {
+                auto const directions = sobol_direction_numbers(j);
+                uint32_t x = engine.uniform<uint32_t>(0,std::numeric_limits<uint32_t>::max());
+                for (size_t i=0; i<amount; ++i) {
+                    result[i][j] = static_cast<double>(x) * 0x1.0p-32;
+                    // Gray code order: the next point flips the direction of the lowest zero bit of the index
+                    unsigned int k = 0;
+                    for (size_t c=i; (c & 1) && k<SOBOL_BITS-1; c >>= 1) ++k;
+                    x ^= directions[k];
+                }
+            }
+            break;
+        }
+        default:
+            HELPER_FAIL_MSG("Unhandled sampling for design coordinates.")
+    }
+    return result;
+}
+
+} // namespace
+
+List<ConfigurationSearchPoint> make_sampled_points(ConfigurationSearchSpace const& space, size_t amount, ConfigurationSearchSampling sampling, RandomEngine& engine) {
+    HELPER_PRECONDITION(amount <= space.total_points())
+    if (amount == 0) return {};
+    auto const& parameters = space.parameters();
+    auto const dimension = space.dimension();
+
+    List<List<size_t>> orders;
+    orders.reserve(dimension);
+    for (auto const& p : parameters) {
+        List<size_t> order(p.values().size());
+        std::iota(order.begin(),order.end(),0);
+        if (not p.is_metric()) std::shuffle(order.begin(),order.end(),engine);
+        orders.push_back(std::move(order));
+    }
+
+    ConfigurationSearchPointSet result;
+    List<int> coordinates(dimension);
+    for (auto const& row : design_coordinates(dimension, amount, sampling, engine)) {
+        for (size_t j=0; j<dimension; ++j) {
+            auto const& values = parameters[j].values();
+            auto position = std::min(static_cast<size_t>(row[j]*static_cast<double>(values.size())), values.size()-1);
+            coordinates[j] = values[orders[j][position]];
+        }
+        if (space.is_feasible(coordinates)) result.insert(space.make_point(coordinates));
+    }
+    if (result.empty()) result.insert(space.initial_point(engine));
+
+    if (result.size() < amount)
+        for (auto const& p : make_extended_set_by_shifting(result.to_set(), amount, engine))
+            result.insert(p);
+
+    return result.points();
+}
+
+} // namespace ProNest
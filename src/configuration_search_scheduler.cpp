@@ -0,0 +1,87 @@
+/***************************************************************************
+ *            configuration_search_scheduler.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include "configuration_search_scheduler.hpp"
+
+namespace ProNest {
+
+ConfigurationSearchScheduler::ConfigurationSearchScheduler(double minimum_budget, double maximum_budget, size_t reduction_factor)
+    : _minimum_budget(minimum_budget), _maximum_budget(maximum_budget), _reduction_factor(reduction_factor) {
+    HELPER_PRECONDITION(minimum_budget > 0)
+    HELPER_PRECONDITION(minimum_budget <= maximum_budget)
+    HELPER_PRECONDITION(reduction_factor > 1)
+    // Tolerate rounding when the ratio of the budgets is an exact power of the reduction factor
+    _num_brackets = 1;
+    for (double budget = minimum_budget*static_cast<double>(reduction_factor); budget <= maximum_budget*(1+1e-9); budget *= static_cast<double>(reduction_factor))
+        ++_num_brackets;
+}
+
+double ConfigurationSearchScheduler::minimum_budget() const {
+    return _minimum_budget;
+}
+
+double ConfigurationSearchScheduler::maximum_budget() const {
+    return _maximum_budget;
+}
+
+size_t ConfigurationSearchScheduler::reduction_factor() const {
+    return _reduction_factor;
+}
+
+size_t ConfigurationSearchScheduler::num_brackets() const {
+    return _num_brackets;
+}
+
+size_t ConfigurationSearchScheduler::bracket_size(size_t bracket) const {
+    HELPER_PRECONDITION(bracket < _num_brackets);
+    size_t power = 1;
+    for (size_t i=0; i<bracket; ++i) power *= _reduction_factor;
+    return (_num_brackets*power + bracket)/(bracket+1);
+}
+
+double ConfigurationSearchScheduler::rung_budget(size_t bracket, size_t rung) const {
+    HELPER_PRECONDITION(bracket < _num_brackets);
+    HELPER_PRECONDITION(rung <= bracket);
+    return _maximum_budget/std::pow(static_cast<double>(_reduction_factor), static_cast<double>(bracket-rung));
+}
+
+size_t ConfigurationSearchScheduler::num_promoted(size_t num_points) const {
+    return std::max<size_t>(1, num_points/_reduction_factor);
+}
+
+ConfigurationSearchEvaluation const& best_at_maximum_budget(List<ConfigurationSearchStage> const& stages) {
+    ConfigurationSearchEvaluation const* result = nullptr;
+    for (auto const& stage : stages)
+        if (stage.rung == stage.bracket and not stage.evaluations.empty() and (result == nullptr or stage.incumbent().cost < result->cost))
+            result = &stage.incumbent();
+    HELPER_ASSERT_MSG(result != nullptr,"No stage has been evaluated at the maximum budget.");
+    return *result;
+}
+
+} // namespace ProNest
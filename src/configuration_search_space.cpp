@@ -26,76 +26,208 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <limits>
 #include "configuration_property_path.hpp"
 #include "configuration_search_point.hpp"
 #include "configuration_search_space.hpp"
 
 namespace ProNest {
 
-using Helper::Pair;
+struct ConfigurationSearchSpace::Data {
+    List<ConfigurationSearchParameter> parameters;
+    std::unordered_map<ConfigurationPropertyPath,size_t> indices;
+    //! \brief The weight of each digit in the mixed-radix encoding
+    List<uint64_t> strides;
+    //! \brief Whether the number of points fits the encoding
+    bool is_encodable;
+    List<ConfigurationSearchConstraint> constraints;
+    //! \brief The indices of the parameters involved in each constraint, ordered as its paths
+    List<List<size_t>> constraint_indices;
+    //! \brief The constraints that can be checked once the values of the parameters up to each index are known
+    List<List<size_t>> constraints_checked_at;
+
+    //! \brief Whether the \a coordinates satisfy the constraint with index \a c
+    bool satisfies(size_t c, List<int> const& coordinates) const {
+        List<int> values;
+        values.reserve(constraint_indices[c].size());
+        for (auto i : constraint_indices[c]) values.push_back(coordinates[i]);
+        return constraints[c].is_satisfied_by(values);
+    }
+};
 
-ConfigurationSearchSpace::ConfigurationSearchSpace(Set<ConfigurationSearchParameter> const& parameters) {
+ConfigurationSearchSpace::ConfigurationSearchSpace(Set<ConfigurationSearchParameter> const& parameters, List<ConfigurationSearchConstraint> const& constraints) {
     //HELPER_PRECONDITION(not parameters.empty());
-    for (auto const& p : parameters)
-        _parameters.push_back(p);
+    auto data = std::make_shared<Data>();
+    for (auto const& p : parameters) {
+        data->indices.insert({p.path(), data->parameters.size()});
+        data->parameters.push_back(p);
+    }
+    data->strides.resize(data->parameters.size());
+    data->is_encodable = true;
+    uint64_t stride = 1;
+    for (size_t i=data->parameters.size(); i>0; --i) {
+        data->strides[i-1] = stride;
+        uint64_t radix = data->parameters[i-1].values().size();
+        if (stride > std::numeric_limits<uint64_t>::max()/radix) data->is_encodable = false;
+        stride *= radix;
+    }
+    data->constraints = constraints;
+    data->constraints_checked_at.resize(data->parameters.size());
+    for (size_t c=0; c<constraints.size(); ++c) {
+        List<size_t> indices;
+        for (auto const& path : constraints[c].paths()) {
+            auto iter = data->indices.find(path);
+            HELPER_ASSERT_MSG(iter != data->indices.end(),"The parameter with path '" << path << "' of constraint '" << constraints[c] << "' is not in the space.");
+            indices.push_back(iter->second);
+        }
+        data->constraints_checked_at[*std::max_element(indices.begin(),indices.end())].push_back(c);
+        data->constraint_indices.push_back(std::move(indices));
+    }
+    _data = data;
 }
 
 ConfigurationSearchPoint ConfigurationSearchSpace::make_point(ParameterBindingsMap const& bindings) const {
     HELPER_PRECONDITION(bindings.size() == this->dimension())
-    ParameterBindingsMap pb;
-    for (auto const& p : _parameters) {
-        int v = bindings.find(p.path())->second;
-        pb.insert(Pair<ConfigurationPropertyPath,int>(p.path(), v));
+    List<int> coordinates;
+    coordinates.reserve(dimension());
+    for (auto const& p : _data->parameters) {
+        auto iter = bindings.find(p.path());
+        HELPER_ASSERT_MSG(iter != bindings.end(),"No binding for parameter '" << p.path() << "' has been supplied.");
+        coordinates.push_back(iter->second);
     }
-    return {*this, pb};
+    return {*this, coordinates};
+}
+
+ConfigurationSearchPoint ConfigurationSearchSpace::make_point(List<int> const& coordinates) const {
+    return {*this, coordinates};
 }
 
-ConfigurationSearchPoint ConfigurationSearchSpace::initial_point() const {
-    ParameterBindingsMap pb;
-    for (auto const& p : _parameters) {
-        pb.insert(Pair<ConfigurationPropertyPath,int>(p.path(), p.random_value()));
+ConfigurationSearchPoint ConfigurationSearchSpace::initial_point(RandomEngine& engine) const {
+    auto const& parameters = _data->parameters;
+    List<int> coordinates;
+    coordinates.reserve(dimension());
+    if (_data->constraints.empty()) {
+        for (auto const& p : parameters) coordinates.push_back(p.random_value(engine));
+        return {*this, coordinates};
     }
-    return {*this, pb};
+
+    // Depth-first search with the values of each parameter tried in random order, where the candidate values of a
+    // parameter are only those satisfying the constraints that become checkable with it
+    coordinates.resize(dimension());
+    List<List<int>> candidates(dimension());
+    auto fill_candidates = [&](size_t i) {
+        candidates[i].clear();
+        for (auto v : parameters[i].values()) {
+            coordinates[i] = v;
+            bool feasible = true;
+            for (auto c : _data->constraints_checked_at[i])
+                if (not _data->satisfies(c, coordinates)) { feasible = false; break; }
+            if (feasible) candidates[i].push_back(v);
+        }
+    };
+    size_t i = 0;
+    fill_candidates(0);
+    while (i < dimension()) {
+        if (candidates[i].empty()) {
+            HELPER_ASSERT_MSG(i > 0,"No feasible point exists in the space.");
+            --i;
+            continue;
+        }
+        auto const position = engine.uniform<size_t>(0,candidates[i].size()-1);
+        coordinates[i] = candidates[i][position];
+        candidates[i][position] = candidates[i].back();
+        candidates[i].pop_back();
+        if (++i < dimension()) fill_candidates(i);
+    }
+    return {*this, coordinates};
 }
 
 size_t ConfigurationSearchSpace::index(ConfigurationSearchParameter const& p) const {
-    for (size_t i=0; i<_parameters.size(); ++i) if (_parameters.at(i) == p) return i;
-    HELPER_FAIL_MSG("Task parameter '" << p << "' not found in the space.");
+    auto iter = _data->indices.find(p.path());
+    HELPER_ASSERT_MSG(iter != _data->indices.end(),"Task parameter '" << p << "' not found in the space.");
+    return iter->second;
 }
 
 size_t ConfigurationSearchSpace::index(ConfigurationPropertyPath const& path) const {
-    for (size_t i=0; i<_parameters.size(); ++i) if (_parameters.at(i).path() == path) return i;
-    HELPER_FAIL_MSG("Task parameter with path '" << path << "' not found in the space.");
+    auto iter = _data->indices.find(path);
+    HELPER_ASSERT_MSG(iter != _data->indices.end(),"Task parameter with path '" << path << "' not found in the space.");
+    return iter->second;
 }
 
 ConfigurationSearchParameter const& ConfigurationSearchSpace::parameter(ConfigurationPropertyPath const& path) const {
-    for (auto const& p : _parameters) if (p.path() == path) return p;
-    HELPER_FAIL_MSG("Task parameter with path '" << path << "' not found in the space.");
+    return _data->parameters[index(path)];
 }
 
 List<ConfigurationSearchParameter> const& ConfigurationSearchSpace::parameters() const {
-    return _parameters;
+    return _data->parameters;
+}
+
+List<ConfigurationSearchConstraint> const& ConfigurationSearchSpace::constraints() const {
+    return _data->constraints;
+}
+
+bool ConfigurationSearchSpace::is_feasible(List<int> const& coordinates) const {
+    HELPER_PRECONDITION(coordinates.size() == dimension());
+    for (size_t c=0; c<_data->constraints.size(); ++c)
+        if (not _data->satisfies(c, coordinates)) return false;
+    return true;
+}
+
+bool ConfigurationSearchSpace::is_feasible(ConfigurationSearchPoint const& point) const {
+    return is_feasible(point.coordinates());
 }
 
 size_t ConfigurationSearchSpace::total_points() const {
     size_t result = 1;
-    for (auto const& p : _parameters) result *= p.values().size();
+    for (auto const& p : _data->parameters) {
+        if (result > std::numeric_limits<size_t>::max() / p.values().size()) return std::numeric_limits<size_t>::max();
+        result *= p.values().size();
+    }
+    return result;
+}
+
+uint64_t ConfigurationSearchSpace::index_of(ConfigurationSearchPoint const& point) const {
+    HELPER_PRECONDITION(_data->is_encodable);
+    HELPER_PRECONDITION(point.coordinates().size() == dimension());
+    uint64_t result = 0;
+    for (size_t i=0; i<_data->parameters.size(); ++i)
+        result += _data->parameters[i].index_of(point.value(i)) * _data->strides[i];
     return result;
 }
 
+ConfigurationSearchPoint ConfigurationSearchSpace::point_at(uint64_t index) const {
+    HELPER_PRECONDITION(_data->is_encodable);
+    HELPER_PRECONDITION(index < total_points());
+    List<int> coordinates;
+    coordinates.reserve(dimension());
+    for (size_t i=0; i<_data->parameters.size(); ++i) {
+        coordinates.push_back(_data->parameters[i].values()[static_cast<size_t>(index / _data->strides[i])]);
+        index %= _data->strides[i];
+    }
+    return {*this, coordinates};
+}
+
 size_t ConfigurationSearchSpace::dimension() const {
-    return _parameters.size();
+    return _data->parameters.size();
 }
 
 ConfigurationSearchSpace* ConfigurationSearchSpace::clone() const {
     return new ConfigurationSearchSpace(*this);
 }
 
+bool ConfigurationSearchSpace::operator==(ConfigurationSearchSpace const& other) const {
+    return _data == other._data or (_data->parameters == other._data->parameters and _data->constraints == other._data->constraints);
+}
+
 ostream& operator<<(ostream& os, ConfigurationSearchSpace const& space) {
+    auto const& parameters = space.parameters();
     os << "[";
-    if (space._parameters.size()>0) {
-        for (size_t i = 0; i < space._parameters.size() - 1; ++i) os << space._parameters[i] << ",";
-        os << space._parameters[space._parameters.size() - 1];
+    if (parameters.size()>0) {
+        for (size_t i = 0; i < parameters.size() - 1; ++i) os << parameters[i] << ",";
+        os << parameters[parameters.size() - 1];
     }
     os << "]";
     return os;
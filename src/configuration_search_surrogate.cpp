@@ -0,0 +1,216 @@
+/***************************************************************************
+ *            configuration_search_surrogate.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <algorithm>
+#include "configuration_search_surrogate.hpp"
+#include "configuration_search_sampling.hpp"
+#include "configuration_search_point_set.hpp"
+
+namespace ProNest {
+
+namespace {
+
+//! \brief The number of best points whose neighbours are candidates
+constexpr size_t NUM_INCUMBENTS = 5;
+
+//! \brief Up to \a amount points of \a space not excluded, most of them by highest expected improvement over \a best_cost
+//! \details Candidates are random points and the neighbours of the \a incumbents, i.e., the best points known. A
+//! \a random_fraction of the result is drawn among the candidates not chosen by expected improvement.
+List<ConfigurationSearchPoint> propose_by_expected_improvement(ConfigurationSearchSpace const& space, ConfigurationSearchForest const& forest,
+                                                               List<ConfigurationSearchPoint> const& incumbents, double best_cost,
+                                                               std::function<bool(ConfigurationSearchPoint const&)> const& is_excluded,
+                                                               size_t amount, size_t num_random_candidates, double random_fraction, RandomEngine& engine) {
+    ConfigurationSearchPointSet candidates;
+    for (size_t i=0; i<num_random_candidates; ++i) {
+        auto point = space.initial_point(engine);
+        if (not is_excluded(point)) candidates.insert(point);
+    }
+    for (auto const& incumbent : incumbents)
+        for (auto const& point : incumbent.neighbours())
+            if (not is_excluded(point)) candidates.insert(point);
+
+    List<double> scores;
+    scores.reserve(candidates.size());
+    for (auto const& point : candidates) scores.push_back(expected_improvement(forest.predict(point), best_cost));
+    List<size_t> order(candidates.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return scores[a] > scores[b]; });
+
+    size_t const result_size = std::min(amount, candidates.size());
+    size_t const num_random = static_cast<size_t>(std::round(random_fraction*static_cast<double>(result_size)));
+    size_t const num_best = result_size - num_random;
+    List<ConfigurationSearchPoint> result;
+    for (size_t i=0; i<num_best; ++i) result.push_back(candidates[order[i]]);
+    // The random part is drawn among the remaining candidates by a partial shuffle
+    for (size_t i=num_best; i<result_size; ++i) {
+        std::swap(order[i], order[engine.uniform<size_t>(i, order.size()-1)]);
+        result.push_back(candidates[order[i]]);
+    }
+    return result;
+}
+
+class SurrogateAskTell : public ConfigurationSearchAskTellOptimiser {
+  public:
+    SurrogateAskTell(ConfigurationSearchSpace const& space, size_t budget, size_t num_initial_points, size_t num_trees,
+                     size_t num_random_candidates, double random_fraction, RandomEngine engine)
+        : ConfigurationSearchAskTellOptimiser(space, budget), _num_initial_points(num_initial_points), _forest(num_trees),
+          _num_random_candidates(num_random_candidates), _random_fraction(random_fraction), _engine(engine) { }
+
+  protected:
+    List<ConfigurationSearchPoint> propose(size_t amount) override {
+        if (not _initial.has_value())
+            _initial = make_sampled_points(space(), std::min({_num_initial_points, budget(), space().total_points()}), ConfigurationSearchSampling::LATIN_HYPERCUBE, _engine);
+        List<ConfigurationSearchPoint> result;
+        for (; _next_initial < _initial->size() and result.size() < amount; ++_next_initial) result.push_back((*_initial)[_next_initial]);
+        if (result.size() == amount or _ranking.empty()) return result;
+
+        // The forest is refitted only if costs have been told since the last fit
+        if (_forest.num_observations() != _num_fitted) {
+            _forest.fit(_engine);
+            _num_fitted = _forest.num_observations();
+        }
+        List<ConfigurationSearchPoint> incumbents;
+        for (size_t r=0; r<std::min(NUM_INCUMBENTS, _ranking.size()); ++r) incumbents.push_back(_ranking[r].first);
+        ConfigurationSearchPointSet chosen(Set<ConfigurationSearchPoint>(result.begin(), result.end()));
+        auto proposed = propose_by_expected_improvement(space(), _forest, incumbents, _ranking.front().second,
+                                                        [&](ConfigurationSearchPoint const& p) { return is_asked(p) or chosen.contains(p); },
+                                                        amount - result.size(), _num_random_candidates, _random_fraction, _engine);
+        result.insert(result.end(), proposed.begin(), proposed.end());
+        return result;
+    }
+
+    void observe(ConfigurationSearchPoint const& point, double cost) override {
+        _forest.add(point, cost);
+        auto position = std::upper_bound(_ranking.begin(), _ranking.end(), cost, [](double c, auto const& p) { return c < p.second; });
+        _ranking.insert(position, {point, cost});
+    }
+
+  private:
+    size_t _num_initial_points;
+    ConfigurationSearchForest _forest;
+    size_t _num_fitted = 0;
+    size_t _num_random_candidates;
+    double _random_fraction;
+    RandomEngine _engine;
+    std::optional<List<ConfigurationSearchPoint>> _initial;
+    size_t _next_initial = 0;
+    //! \brief The points told with their costs, by increasing cost
+    List<std::pair<ConfigurationSearchPoint,double>> _ranking;
+};
+
+} // namespace
+
+double expected_improvement(ConfigurationSearchPrediction const& prediction, double best_cost) {
+    double const improvement = best_cost - prediction.mean;
+    double const deviation = std::sqrt(prediction.variance);
+    if (deviation <= 0.0) return std::max(improvement, 0.0);
+    double const z = improvement/deviation;
+    double const density = std::exp(-0.5*z*z)/std::sqrt(2*std::numbers::pi);
+    double const distribution = 0.5*std::erfc(-z/std::sqrt(2.0));
+    return improvement*distribution + deviation*density;
+}
+
+ConfigurationSearchSurrogateOptimiser::ConfigurationSearchSurrogateOptimiser(size_t num_initial_points, size_t batch_size, size_t num_batches)
+    : _num_initial_points(num_initial_points), _batch_size(batch_size), _num_batches(num_batches),
+      _num_trees(16), _num_random_candidates(256), _random_fraction(0.2), _concurrency(1) {
+    HELPER_PRECONDITION(num_initial_points > 0)
+    HELPER_PRECONDITION(batch_size > 0)
+}
+
+void ConfigurationSearchSurrogateOptimiser::set_num_trees(size_t num_trees) {
+    HELPER_PRECONDITION(num_trees > 0)
+    _num_trees = num_trees;
+}
+
+void ConfigurationSearchSurrogateOptimiser::set_num_random_candidates(size_t num_candidates) {
+    _num_random_candidates = num_candidates;
+}
+
+void ConfigurationSearchSurrogateOptimiser::set_random_fraction(double fraction) {
+    HELPER_PRECONDITION(fraction >= 0 and fraction <= 1)
+    _random_fraction = fraction;
+}
+
+void ConfigurationSearchSurrogateOptimiser::set_concurrency(size_t concurrency) {
+    HELPER_PRECONDITION(concurrency > 0)
+    _concurrency = concurrency;
+}
+
+void ConfigurationSearchSurrogateOptimiser::set_cache(std::shared_ptr<ConfigurationSearchEvaluationCache> cache) {
+    _cache = std::move(cache);
+}
+
+ConfigurationSearchSurrogateResult ConfigurationSearchSurrogateOptimiser::optimise(ConfigurationSearchSpace const& space, Cost const& cost,
+                                                                                  RandomEngine& engine, CancellationToken const& cancellation) const {
+    ConfigurationSearchEvaluator evaluator(_concurrency, _cache);
+    ConfigurationSearchForest forest(_num_trees);
+    ConfigurationSearchPointSet evaluated;
+    List<ConfigurationSearchEvaluation> evaluations;
+    // The positions in the evaluations by increasing cost
+    List<size_t> ranking;
+
+    auto evaluate = [&](List<ConfigurationSearchPoint> const& points, CancellationToken const& token) {
+        for (auto& evaluation : evaluator.evaluate(points, cost, token)) {
+            evaluated.insert(evaluation.point);
+            forest.add(evaluation.point, evaluation.cost);
+            ranking.push_back(evaluations.size());
+            evaluations.push_back(std::move(evaluation));
+        }
+        std::stable_sort(ranking.begin(), ranking.end(), [&](size_t a, size_t b) { return evaluations[a].cost < evaluations[b].cost; });
+    };
+
+    auto propose = [&]() {
+        List<ConfigurationSearchPoint> incumbents;
+        for (size_t r=0; r<std::min(NUM_INCUMBENTS, ranking.size()); ++r) incumbents.push_back(evaluations[ranking[r]].point);
+        return propose_by_expected_improvement(space, forest, incumbents, evaluations[ranking.front()].cost,
+                                               [&](ConfigurationSearchPoint const& p) { return evaluated.contains(p); },
+                                               _batch_size, _num_random_candidates, _random_fraction, engine);
+    };
+
+    // The initial design is never cut short, so that there is always a best point
+    evaluate(make_sampled_points(space, std::min(_num_initial_points, space.total_points()), ConfigurationSearchSampling::LATIN_HYPERCUBE, engine), CancellationToken());
+    for (size_t b=0; b<_num_batches and not cancellation.is_cancelled(); ++b) {
+        forest.fit(engine, _concurrency);
+        auto batch = propose();
+        if (batch.empty()) break;
+        evaluate(batch, cancellation);
+    }
+
+    auto const& best = evaluations[ranking.front()];
+    return {best.point, best.cost, evaluations};
+}
+
+std::shared_ptr<ConfigurationSearchAskTellOptimiser> ConfigurationSearchSurrogateOptimiser::make_ask_tell(ConfigurationSearchSpace const& space, size_t budget, RandomEngine& engine) const {
+    return std::make_shared<SurrogateAskTell>(space, budget, _num_initial_points, _num_trees, _num_random_candidates, _random_fraction, engine.split());
+}
+
+} // namespace ProNest
@@ -0,0 +1,91 @@
+/***************************************************************************
+ *            random_engine.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <random>
+#include "random_engine.hpp"
+
+namespace ProNest {
+
+namespace {
+
+uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+} // namespace
+
+RandomEngine::RandomEngine(uint64_t seed, uint64_t stream) {
+    uint64_t stream_mix = stream;
+    uint64_t x = seed ^ splitmix64(stream_mix);
+    for (auto& s : _state) s = splitmix64(x);
+}
+
+RandomEngine::result_type RandomEngine::operator()() {
+    uint64_t const result = rotl(_state[1] * 5, 7) * 9;
+    uint64_t const t = _state[1] << 17;
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = rotl(_state[3], 45);
+    return result;
+}
+
+uint64_t RandomEngine::_bounded(uint64_t range) {
+    if (range == 0) return (*this)();
+    uint64_t const threshold = (0 - range) % range; // Rejecting below the threshold removes the modulo bias
+    while (true) {
+        uint64_t value = (*this)();
+        if (value >= threshold) return value % range;
+    }
+}
+
+double RandomEngine::canonical() {
+    return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+}
+
+RandomEngine RandomEngine::split() {
+    uint64_t seed = (*this)();
+    uint64_t stream = (*this)();
+    return RandomEngine(seed, stream);
+}
+
+RandomEngine& RandomEngine::thread_engine() {
+    static thread_local RandomEngine engine((static_cast<uint64_t>(std::random_device()()) << 32) ^ std::random_device()());
+    return engine;
+}
+
+} // namespace ProNest
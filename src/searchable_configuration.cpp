@@ -26,6 +26,10 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <mutex>
+#include <iterator>
+#include <functional>
+#include <optional>
 #include "helper/container.hpp"
 #include "searchable_configuration.hpp"
 #include "configuration_search_space.hpp"
@@ -35,26 +39,137 @@ namespace ProNest {
 using Helper::Pair;
 using std::shared_ptr;
 
-SearchableConfiguration::SearchableConfiguration(SearchableConfiguration const& c) {
-    for (auto const& p : c.properties()) _properties.insert(Pair<String,shared_ptr<ConfigurationPropertyInterface>>(p.first,shared_ptr<ConfigurationPropertyInterface>(p.second->clone())));
+struct SearchableConfiguration::Cache {
+    //! \brief The content obtained from a single property, with paths starting from the configuration
+    struct Entry {
+        size_t version;
+        Map<ConfigurationPropertyPath,List<int>> integer_values;
+        List<ConfigurationSearchParameter> parameters;
+    };
+
+    std::mutex mutex;
+    //! \brief The latest version drawn when the version was computed, zero if never computed
+    size_t epoch = 0;
+    size_t version = 0;
+    //! \brief The version the content refers to, zero if never computed
+    size_t content_version = 0;
+    Map<String,Entry> entries;
+    Map<ConfigurationPropertyPath,List<int>> integer_values;
+    ConfigurationSearchSpace search_space = ConfigurationSearchSpace(Set<ConfigurationSearchParameter>());
+    //! \brief The first constraint not satisfied by the single values, if any
+    std::optional<ConfigurationSearchConstraint> unsatisfied_constraint;
+    bool is_singleton = true;
+};
+
+SearchableConfiguration::SearchableConfiguration()
+    : _schema(ConfigurationPropertyInterface::next_version()), _structure_version(ConfigurationPropertyInterface::next_version()), _cache(new Cache()) { }
+
+SearchableConfiguration::SearchableConfiguration(SearchableConfiguration const& c)
+    : _properties(c._properties), _constraints(c._constraints), _schema(c._schema), _structure_version(c._structure_version), _cache(new Cache()) {
+    _update_ordered_properties();
 }
 
+SearchableConfiguration::SearchableConfiguration(SearchableConfiguration&& c)
+    : _properties(std::move(c._properties)), _constraints(std::move(c._constraints)), _schema(c._schema), _structure_version(c._structure_version), _cache(new Cache()) {
+    _update_ordered_properties();
+    c._update_ordered_properties();
+    c._schema = ConfigurationPropertyInterface::next_version();
+    c._structure_version = ConfigurationPropertyInterface::next_version();
+}
+
+SearchableConfiguration::~SearchableConfiguration() = default;
+
 SearchableConfiguration& SearchableConfiguration::operator=(SearchableConfiguration const& c) {
-    _properties.clear();
-    for (auto const& p : c.properties()) _properties.insert(Pair<String,shared_ptr<ConfigurationPropertyInterface>>(p.first,shared_ptr<ConfigurationPropertyInterface>(p.second->clone())));
+    _properties = c._properties;
+    _constraints = c._constraints;
+    _update_ordered_properties();
+    _schema = c._schema;
+    _structure_version = ConfigurationPropertyInterface::next_version();
     return *this;
 }
 
-Map<String,shared_ptr<ConfigurationPropertyInterface>>& SearchableConfiguration::properties() {
-    return _properties;
+SearchableConfiguration& SearchableConfiguration::operator=(SearchableConfiguration&& c) {
+    _properties = std::move(c._properties);
+    _constraints = std::move(c._constraints);
+    _update_ordered_properties();
+    c._update_ordered_properties();
+    _schema = c._schema;
+    c._schema = ConfigurationPropertyInterface::next_version();
+    _structure_version = ConfigurationPropertyInterface::next_version();
+    c._structure_version = ConfigurationPropertyInterface::next_version();
+    return *this;
 }
 
-Map<String,shared_ptr<ConfigurationPropertyInterface>> const& SearchableConfiguration::properties() const {
-    return _properties;
+Map<String,shared_ptr<const ConfigurationPropertyInterface>> SearchableConfiguration::properties() const {
+    Map<String,shared_ptr<const ConfigurationPropertyInterface>> result;
+    for (auto const& p : _properties) result.insert(Pair<String,shared_ptr<const ConfigurationPropertyInterface>>({p.first, p.second}));
+    return result;
+}
+
+void SearchableConfiguration::_update_ordered_properties() {
+    _ordered_properties.clear();
+    for (auto& p : _properties) _ordered_properties.push_back(&p.second);
+}
+
+size_t SearchableConfiguration::_ordinal(String const& name) const {
+    auto prop_ptr = _properties.find(name);
+    HELPER_ASSERT_MSG(prop_ptr != _properties.end(),"The property '" << name << "' was not found in the configuration.");
+    return static_cast<size_t>(std::distance(_properties.begin(),prop_ptr));
+}
+
+shared_ptr<ConfigurationPropertyInterface> const& SearchableConfiguration::_detached_property(size_t ordinal) {
+    auto& property = *_ordered_properties[ordinal];
+    if (property.use_count() > 1) property.reset(property->clone());
+    return property;
+}
+
+shared_ptr<ConfigurationPropertyInterface> const& SearchableConfiguration::_detached_property(String const& name) {
+    auto prop_ptr = _properties.find(name);
+    HELPER_ASSERT_MSG(prop_ptr != _properties.end(),"The property '" << name << "' was not found in the configuration.");
+    if (prop_ptr->second.use_count() > 1) prop_ptr->second.reset(prop_ptr->second->clone());
+    return prop_ptr->second;
+}
+
+ConfigurationPropertyInterface const& SearchableConfiguration::property_at(ConfigurationPropertyPath const& path) const {
+    auto prop_ptr = _properties.find(path.first());
+    HELPER_ASSERT_MSG(prop_ptr != _properties.end(),"The property '" << path.first() << "' was not found in the configuration.");
+    ConfigurationPropertyInterface const& property = *prop_ptr->second;
+    return *property.at(path.subpath());
+}
+
+ConfigurationPropertyInterface& SearchableConfiguration::property_at(ConfigurationPropertyPath const& path) {
+    return *_detached_property(path.first())->at(path.subpath());
+}
+
+void SearchableConfiguration::set_single(ConfigurationPropertyPath const& path, int integer_value) {
+    _detached_property(path.first())->set_single(path.subpath(), integer_value);
 }
 
 void SearchableConfiguration::add_property(String const& name, ConfigurationPropertyInterface const& property) {
     _properties.insert(Pair<String,shared_ptr<ConfigurationPropertyInterface>>({name,shared_ptr<ConfigurationPropertyInterface>(property.clone())}));
+    _update_ordered_properties();
+    _schema = ConfigurationPropertyInterface::next_version();
+    _structure_version = ConfigurationPropertyInterface::next_version();
+}
+
+void SearchableConfiguration::replace_property(String const& name, ConfigurationPropertyInterface const& property) {
+    auto prop_ptr = _properties.find(name);
+    HELPER_ASSERT_MSG(prop_ptr != _properties.end(),"The property '" << name << "' was not found in the configuration.");
+    prop_ptr->second.reset(property.clone());
+    _schema = ConfigurationPropertyInterface::next_version();
+    _structure_version = ConfigurationPropertyInterface::next_version();
+}
+
+void SearchableConfiguration::add_constraint(ConfigurationSearchConstraint const& constraint) {
+    auto values = integer_values();
+    for (auto const& path : constraint.paths())
+        HELPER_ASSERT_MSG(values.find(path) != values.end(),"The path '" << path << "' of constraint '" << constraint << "' is not a property with integer values.");
+    _constraints.push_back(constraint);
+    _structure_version = ConfigurationPropertyInterface::next_version();
+}
+
+List<ConfigurationSearchConstraint> const& SearchableConfiguration::constraints() const {
+    return _constraints;
 }
 
 ostream& SearchableConfiguration::_write(ostream& os) const {
@@ -67,28 +182,94 @@ ostream& SearchableConfiguration::_write(ostream& os) const {
     os << iter->first << " = " << *iter->second << ")"; return os;
 }
 
-bool SearchableConfiguration::is_singleton() const {
-    for (auto const& p : _properties) {
-        auto int_values = p.second->integer_values();
-        for (auto const& p_int : int_values) if (p_int.second.size() > 1) return false;
+size_t SearchableConfiguration::_locked_version() const {
+    auto latest = ConfigurationPropertyInterface::latest_version();
+    if (_cache->epoch != latest) {
+        size_t result = _structure_version;
+        for (auto const& p : _properties) result = std::max(result, p.second->version());
+        _cache->version = result;
+        _cache->epoch = latest;
     }
-    return true;
+    return _cache->version;
 }
 
-ConfigurationSearchSpace SearchableConfiguration::search_space() const {
-    Set<ConfigurationSearchParameter> result;
+void SearchableConfiguration::_locked_refresh() const {
+    auto version = _locked_version();
+    if (_cache->content_version == version) return;
+
+    Map<String,Cache::Entry> entries;
     for (auto const& p : _properties) {
-        auto integer_values = p.second->integer_values();
-        for (auto const& p_int : integer_values) {
-            if (p_int.second.size() > 1) {
-                ConfigurationPropertyPath path(p_int.first);
-                path.prepend(p.first);
-                result.insert(ConfigurationSearchParameter(path, p.second->is_metric(p_int.first), p_int.second));
+        auto property_version = p.second->version();
+        auto entry_ptr = _cache->entries.find(p.first);
+        if (entry_ptr != _cache->entries.end() and entry_ptr->second.version == property_version) {
+            entries.insert(Pair<String,Cache::Entry>(p.first,std::move(entry_ptr->second)));
+            continue;
+        }
+        Cache::Entry entry({property_version,{},{}});
+        for (auto const& p_int : p.second->integer_values()) {
+            ConfigurationPropertyPath path(p_int.first);
+            path.prepend(p.first);
+            if (p_int.second.size() > 1)
+                entry.parameters.push_back(ConfigurationSearchParameter(path, p.second->is_metric(p_int.first), p_int.second));
+            entry.integer_values.insert(Pair<ConfigurationPropertyPath,List<int>>(path,p_int.second));
+        }
+        entries.insert(Pair<String,Cache::Entry>(p.first,std::move(entry)));
+    }
+
+    Map<ConfigurationPropertyPath,List<int>> integer_values;
+    Set<ConfigurationSearchParameter> parameters;
+    for (auto const& e : entries) {
+        integer_values.insert(e.second.integer_values.begin(),e.second.integer_values.end());
+        for (auto const& param : e.second.parameters) parameters.insert(param);
+    }
+
+    List<ConfigurationSearchConstraint> constraints;
+    std::optional<ConfigurationSearchConstraint> unsatisfied_constraint;
+    for (auto const& c : _constraints) {
+        Map<ConfigurationPropertyPath,int> single_values;
+        List<int> values;
+        for (auto const& path : c.paths()) {
+            auto values_ptr = integer_values.find(path);
+            HELPER_ASSERT_MSG(values_ptr != integer_values.end(),"The path '" << path << "' of constraint '" << c << "' is not a property with integer values.");
+            if (values_ptr->second.size() == 1) {
+                single_values.insert(Pair<ConfigurationPropertyPath,int>(path,values_ptr->second.front()));
+                values.push_back(values_ptr->second.front());
             }
         }
+        if (values.size() < c.paths().size()) constraints.push_back(single_values.empty() ? c : c.bind(single_values));
+        else if (not unsatisfied_constraint.has_value() and not c.is_satisfied_by(values)) unsatisfied_constraint = c;
     }
-    //HELPER_ASSERT_MSG(not result.empty(),"The search space is empty.");
-    return result;
+
+    _cache->entries = std::move(entries);
+    _cache->integer_values = std::move(integer_values);
+    _cache->is_singleton = parameters.empty();
+    _cache->search_space = ConfigurationSearchSpace(parameters, constraints);
+    _cache->unsatisfied_constraint = std::move(unsatisfied_constraint);
+    _cache->content_version = version;
+}
+
+size_t SearchableConfiguration::version() const {
+    std::lock_guard<std::mutex> lock(_cache->mutex);
+    return _locked_version();
+}
+
+Map<ConfigurationPropertyPath,List<int>> SearchableConfiguration::integer_values() const {
+    std::lock_guard<std::mutex> lock(_cache->mutex);
+    _locked_refresh();
+    return _cache->integer_values;
+}
+
+bool SearchableConfiguration::is_singleton() const {
+    std::lock_guard<std::mutex> lock(_cache->mutex);
+    _locked_refresh();
+    return _cache->is_singleton;
+}
+
+ConfigurationSearchSpace SearchableConfiguration::search_space() const {
+    std::lock_guard<std::mutex> lock(_cache->mutex);
+    _locked_refresh();
+    HELPER_ASSERT_MSG(not _cache->unsatisfied_constraint.has_value(),"The single values of the configuration do not satisfy constraint '" << *_cache->unsatisfied_constraint << "'.");
+    return _cache->search_space;
 }
 
 } // namespace ProNest
@@ -0,0 +1,169 @@
+/***************************************************************************
+ *            work_stealing_pool.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/macros.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace ProNest {
+
+namespace {
+thread_local bool is_worker_thread = false;
+} // namespace
+
+CancellationToken::CancellationToken() : _cancelled(std::make_shared<std::atomic<bool>>(false)) { }
+
+void CancellationToken::cancel() {
+    _cancelled->store(true, std::memory_order_relaxed);
+}
+
+bool CancellationToken::is_cancelled() const {
+    return _cancelled->load(std::memory_order_relaxed);
+}
+
+struct WorkStealingPool::Worker {
+    std::mutex mutex;
+    std::deque<size_t> indices;
+};
+
+WorkStealingPool::WorkStealingPool(size_t concurrency) : _task(nullptr), _queued(0), _remaining(0), _stopping(false) {
+    HELPER_PRECONDITION(concurrency > 0)
+    for (size_t w=0; w<concurrency; ++w) _workers.push_back(std::make_unique<Worker>());
+    for (size_t w=0; w<concurrency; ++w) _threads.emplace_back([this,w]{ _loop(w); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _work_available.notify_all();
+    for (auto& thread : _threads) thread.join();
+}
+
+size_t WorkStealingPool::concurrency() const {
+    return _workers.size();
+}
+
+void WorkStealingPool::run(size_t count, std::function<void(size_t)> const& task, CancellationToken const& cancellation) {
+    HELPER_PRECONDITION(not is_worker_thread)
+    if (count == 0) return;
+    std::lock_guard<std::mutex> run_lock(_run_mutex);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _task = &task;
+    _cancellation = cancellation;
+    _remaining = count;
+    _exception = nullptr;
+    // Indices are dealt while holding the lock, so that workers taking them early still see the current batch
+    _queued.store(count);
+    size_t const num_workers = _workers.size();
+    for (size_t w=0; w<num_workers; ++w) {
+        std::lock_guard<std::mutex> worker_lock(_workers[w]->mutex);
+        for (size_t i=count*w/num_workers; i<count*(w+1)/num_workers; ++i) _workers[w]->indices.push_back(i);
+    }
+    _work_available.notify_all();
+    _batch_completed.wait(lock, [this]{ return _remaining == 0; });
+    _task = nullptr;
+    if (_exception != nullptr) std::rethrow_exception(_exception);
+}
+
+bool WorkStealingPool::_take(size_t worker, size_t& index) {
+    size_t const num_workers = _workers.size();
+    {
+        auto& own = *_workers[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (not own.indices.empty()) {
+            index = own.indices.back();
+            own.indices.pop_back();
+            _queued.fetch_sub(1);
+            return true;
+        }
+    }
+    for (size_t offset=1; offset<num_workers; ++offset) {
+        auto& victim = *_workers[(worker+offset)%num_workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (not victim.indices.empty()) {
+            index = victim.indices.front();
+            victim.indices.pop_front();
+            _queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::_loop(size_t worker) {
+    is_worker_thread = true;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _work_available.wait(lock, [this]{ return _stopping or _queued.load() > 0; });
+            if (_stopping) return;
+        }
+        size_t index;
+        while (_take(worker, index)) {
+            std::function<void(size_t)> const* task;
+            bool skip;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                task = _task;
+                skip = (_exception != nullptr or _cancellation.is_cancelled());
+            }
+            if (not skip) {
+                try { (*task)(index); }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_exception == nullptr) _exception = std::current_exception();
+                }
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_remaining == 0) _batch_completed.notify_all();
+        }
+    }
+}
+
+void run_concurrently(size_t count, size_t concurrency, std::function<void(size_t)> const& task, CancellationToken const& cancellation) {
+    HELPER_PRECONDITION(concurrency > 0)
+    // A task of a pool cannot wait on a pool, since it may be the same
+    if (concurrency == 1 or count <= 1 or is_worker_thread) {
+        for (size_t i=0; i<count and not cancellation.is_cancelled(); ++i) task(i);
+        return;
+    }
+    static std::mutex pools_mutex;
+    static Map<size_t,std::unique_ptr<WorkStealingPool>> pools;
+    WorkStealingPool* pool;
+    {
+        std::lock_guard<std::mutex> lock(pools_mutex);
+        auto& entry = pools[concurrency];
+        if (entry == nullptr) entry = std::make_unique<WorkStealingPool>(concurrency);
+        pool = entry.get();
+    }
+    pool->run(count, task, cancellation);
+}
+
+} // namespace ProNest
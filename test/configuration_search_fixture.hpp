@@ -0,0 +1,79 @@
+/***************************************************************************
+ *            test/configuration_search_fixture.hpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file configuration_search_fixture.hpp
+ *  \brief Search spaces, configurations and costs shared by the tests of the search algorithms.
+ */
+
+#ifndef PRONEST_TEST_CONFIGURATION_SEARCH_FIXTURE_HPP
+#define PRONEST_TEST_CONFIGURATION_SEARCH_FIXTURE_HPP
+
+#include "searchable_configuration.hpp"
+#include "configuration_property.tpl.hpp"
+#include "configuration_search_space.hpp"
+#include "configuration_search_point.hpp"
+
+using IntegerConfigurationProperty = ProNest::RangeConfigurationProperty<int>;
+
+class TestSearchable;
+
+namespace ProNest {
+
+//! \brief A configuration with an integer property order from 0 to 8 and an integer property depth from 1 to 3
+template<> struct Configuration<TestSearchable> : public SearchableConfiguration {
+  public:
+    Configuration() {
+        add_property("order",IntegerConfigurationProperty(0,8));
+        add_property("depth",IntegerConfigurationProperty(1,3));
+    }
+    int const& order() const { return at<IntegerConfigurationProperty>("order").get(); }
+    int const& depth() const { return at<IntegerConfigurationProperty>("depth").get(); }
+};
+
+//! \brief A cost on singletons of Configuration<TestSearchable>, with a single minimum of one at order=6, depth=1
+inline double configuration_bowl(Configuration<TestSearchable> const& c) {
+    return (c.order()-6)*(c.order()-6) + c.depth();
+}
+
+//! \brief A space of two metric parameters x and y, with values from 0 to 20 each
+inline ConfigurationSearchSpace make_bowl_space() {
+    List<int> values;
+    for (int i=0; i<=20; ++i) values.push_back(i);
+    ConfigurationSearchParameter xp(ConfigurationPropertyPath("x"), true, values);
+    ConfigurationSearchParameter yp(ConfigurationPropertyPath("y"), true, values);
+    return ConfigurationSearchSpace({xp, yp});
+}
+
+//! \brief A cost on the points of make_bowl_space, with a single minimum of zero at x=13, y=4
+inline double bowl(ConfigurationSearchPoint const& p) {
+    return (p.value(0)-13)*(p.value(0)-13) + (p.value(1)-4)*(p.value(1)-4);
+}
+
+} // namespace ProNest
+
+#endif // PRONEST_TEST_CONFIGURATION_SEARCH_FIXTURE_HPP
@@ -95,6 +95,31 @@ class TestConfigurationPropertyPath {
         HELPER_TEST_ASSERT(p2<p1);
     }
 
+    void test_interning() {
+        ConfigurationPropertyPath p1;
+        p1.append("child1").append("child2");
+        ConfigurationPropertyPath p2("child2");
+        p2.prepend("child1");
+        HELPER_TEST_EQUAL(p1,p2);
+        HELPER_TEST_EQUALS(p1.id(),p2.id());
+        HELPER_TEST_EQUALS(p1.hash(),p2.hash());
+        HELPER_TEST_EQUALS(std::hash<ConfigurationPropertyPath>()(p1),p1.hash());
+        auto p3 = p1.subpath();
+        HELPER_TEST_EQUAL(p3,ConfigurationPropertyPath("child2"));
+        HELPER_TEST_ASSERT(p1.id() != p3.id());
+        HELPER_TEST_EQUAL(ConfigurationPropertyPath().subpath(),ConfigurationPropertyPath());
+    }
+
+    void test_parse() {
+        HELPER_TEST_EQUAL(ConfigurationPropertyPath::parse(""),ConfigurationPropertyPath());
+        HELPER_TEST_EQUAL(ConfigurationPropertyPath::parse("./"),ConfigurationPropertyPath());
+        auto p = ConfigurationPropertyPath::parse("child1/child2");
+        HELPER_TEST_EQUALS(p.repr(),"./child1/child2/");
+        HELPER_TEST_EQUAL(ConfigurationPropertyPath::parse(p.repr()),p);
+        HELPER_TEST_EQUALS(p.first(),"child1");
+        HELPER_TEST_EQUALS(p.last(),"child2");
+    }
+
     void test() {
         HELPER_TEST_CALL(test_construction());
         HELPER_TEST_CALL(test_append());
@@ -102,6 +127,8 @@ class TestConfigurationPropertyPath {
         HELPER_TEST_CALL(test_first_last_subpath());
         HELPER_TEST_CALL(test_copy());
         HELPER_TEST_CALL(test_less_equal());
+        HELPER_TEST_CALL(test_interning());
+        HELPER_TEST_CALL(test_parse());
     }
 };
 
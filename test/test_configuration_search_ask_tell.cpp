@@ -0,0 +1,256 @@
+/***************************************************************************
+ *            test/test_configuration_search_ask_tell.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <deque>
+#include <thread>
+#include "helper/test.hpp"
+#include "configuration_search_coroutine.hpp"
+#include "configuration_search_evolution.hpp"
+#include "configuration_search_local_search.hpp"
+#include "configuration_search_surrogate.hpp"
+#include "configuration_search_point_set.hpp"
+#include "configuration_search_fixture.hpp"
+
+using namespace ProNest;
+
+//! \brief A queue of evaluations run by a few threads, completing the awaiting coroutines
+class TestEvaluationQueue {
+  public:
+    TestEvaluationQueue(size_t num_threads) {
+        for (size_t i=0; i<num_threads; ++i) _threads.emplace_back([this]() { _run(); });
+    }
+
+    ~TestEvaluationQueue() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _available.notify_all();
+        for (auto& thread : _threads) thread.join();
+    }
+
+    ConfigurationSearchCompletion submit(ConfigurationSearchPoint const& point) {
+        ConfigurationSearchCompletion completion;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _jobs.emplace_back(point, completion);
+        }
+        _available.notify_one();
+        return completion;
+    }
+
+  private:
+    void _run() {
+        while (true) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _available.wait(lock, [this]() { return _stopping or not _jobs.empty(); });
+            if (_jobs.empty()) return;
+            auto job = _jobs.front();
+            _jobs.pop_front();
+            lock.unlock();
+            auto const& p = job.first;
+            job.second.complete((p.value(0)-13)*(p.value(0)-13) + (p.value(1)-4)*(p.value(1)-4));
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _available;
+    std::deque<std::pair<ConfigurationSearchPoint,ConfigurationSearchCompletion>> _jobs;
+    bool _stopping = false;
+    List<std::thread> _threads;
+};
+
+// The state machine generated by GCC for coroutine bodies has a switch without a default case
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+
+ConfigurationSearchTask evaluate_until_finished(ConfigurationSearchAskTellDriver* driver, TestEvaluationQueue* queue, std::atomic<size_t>* num_finished) {
+    while (auto point = co_await driver->ask()) {
+        double const cost = co_await queue->submit(*point);
+        driver->tell(*point, cost);
+    }
+    ++*num_finished;
+}
+
+ConfigurationSearchTask await_failure(ConfigurationSearchCompletion completion, bool* has_thrown) {
+    try { co_await completion; }
+    catch (std::runtime_error const&) { *has_thrown = true; }
+}
+
+#pragma GCC diagnostic pop
+
+class TestConfigurationSearchAskTell {
+  public:
+
+    //! \brief Ask in batches and tell in reverse order until finished, checking that no point is asked twice
+    void drive(ConfigurationSearchAskTellOptimiser& optimiser, size_t batch_size) {
+        ConfigurationSearchPointSet asked;
+        while (not optimiser.is_finished()) {
+            auto points = optimiser.ask(batch_size);
+            HELPER_TEST_ASSERT(not points.empty());
+            if (points.empty()) return;
+            for (auto const& p : points) HELPER_TEST_ASSERT(asked.insert(p));
+            for (auto iter = points.rbegin(); iter != points.rend(); ++iter) optimiser.tell(*iter, bowl(*iter));
+        }
+        HELPER_TEST_EQUALS(optimiser.num_told(),asked.size());
+        HELPER_TEST_EQUALS(optimiser.num_pending(),0);
+    }
+
+    void test_sampled() {
+        auto space = make_bowl_space();
+        RandomEngine engine(1);
+        auto optimiser = make_sampled_ask_tell(space, 6, ConfigurationSearchSampling::SOBOL, engine);
+        HELPER_TEST_ASSERT(not optimiser->has_best());
+        auto first = optimiser->ask(4);
+        HELPER_TEST_EQUALS(first.size(),4);
+        auto second = optimiser->ask(4);
+        HELPER_TEST_EQUALS(second.size(),2);
+        HELPER_TEST_ASSERT(optimiser->ask(1).empty());
+        HELPER_TEST_EQUALS(optimiser->num_pending(),6);
+        HELPER_TEST_FAIL(optimiser->tell(space.make_point(List<int>({20, 20})), 0.0));
+        for (auto const& p : second) optimiser->tell(p, bowl(p));
+        HELPER_TEST_FAIL(optimiser->tell(second.front(), 0.0));
+        HELPER_TEST_ASSERT(not optimiser->is_finished());
+        for (auto const& p : first) optimiser->tell(p, bowl(p));
+        HELPER_TEST_ASSERT(optimiser->is_finished());
+        double best_cost = bowl(first.front());
+        for (auto const& p : first) best_cost = std::min(best_cost, bowl(p));
+        for (auto const& p : second) best_cost = std::min(best_cost, bowl(p));
+        HELPER_TEST_EQUALS(optimiser->best_cost(),best_cost);
+        HELPER_TEST_EQUALS(bowl(optimiser->best()),best_cost);
+    }
+
+    void test_exhausted() {
+        ConfigurationSearchParameter xp(ConfigurationPropertyPath("x"), true, List<int>({0, 1}));
+        ConfigurationSearchSpace space({xp});
+        RandomEngine engine(2);
+        auto optimiser = make_sampled_ask_tell(space, 10, ConfigurationSearchSampling::UNIFORM, engine);
+        auto points = optimiser->ask(10);
+        HELPER_TEST_EQUALS(points.size(),2);
+        for (auto const& p : points) optimiser->tell(p, p.value(0));
+        HELPER_TEST_ASSERT(optimiser->ask(1).empty());
+        HELPER_TEST_ASSERT(optimiser->is_finished());
+    }
+
+    void test_evolution() {
+        auto space = make_bowl_space();
+        RandomEngine engine(3);
+        ConfigurationSearchEvolution evolution(12, 1);
+        auto optimiser = evolution.make_ask_tell(space, 200, engine);
+        drive(*optimiser, 5);
+        HELPER_TEST_EQUALS(optimiser->num_told(),200);
+        HELPER_TEST_EQUALS(optimiser->best(),space.make_point(List<int>({13, 4})));
+    }
+
+    void test_local_search() {
+        auto space = make_bowl_space();
+        RandomEngine engine(4);
+        ConfigurationSearchLocalSearch search(GreedyAcceptance(), 1);
+        search.set_num_chains(3);
+        search.set_tabu_tenure(4);
+        search.set_restart_after(10);
+        auto optimiser = search.make_ask_tell(space, 150, engine);
+        HELPER_TEST_EQUALS(optimiser->ask(10).size(),3);
+        HELPER_TEST_ASSERT(optimiser->ask(10).empty());
+        auto other = search.make_ask_tell(space, 150, engine);
+        drive(*other, 2);
+        HELPER_TEST_EQUALS(other->best(),space.make_point(List<int>({13, 4})));
+        HELPER_TEST_EQUALS(other->num_told(),150);
+        auto whole = search.make_ask_tell(space, space.total_points(), engine);
+        drive(*whole, 3);
+        HELPER_TEST_EQUALS(whole->num_told(),space.total_points());
+        HELPER_TEST_ASSERT(whole->is_finished());
+
+        search.set_tempering(2.0, 5);
+        HELPER_TEST_FAIL(search.make_ask_tell(space, 150, engine));
+    }
+
+    void test_surrogate() {
+        auto space = make_bowl_space();
+        RandomEngine engine(5);
+        ConfigurationSearchSurrogateOptimiser surrogate(8, 1, 1);
+        auto optimiser = surrogate.make_ask_tell(space, 80, engine);
+        auto initial = optimiser->ask(10);
+        HELPER_TEST_EQUALS(initial.size(),8);
+        HELPER_TEST_ASSERT(optimiser->ask(1).empty());
+        optimiser->tell(initial.back(), bowl(initial.back()));
+        HELPER_TEST_EQUALS(optimiser->ask(3).size(),3);
+        auto other = surrogate.make_ask_tell(space, 80, engine);
+        drive(*other, 4);
+        HELPER_TEST_EQUALS(other->best(),space.make_point(List<int>({13, 4})));
+    }
+
+    void test_completion() {
+        ConfigurationSearchCompletion completion;
+        completion.complete(2.0);
+        HELPER_TEST_FAIL(completion.complete(3.0));
+        HELPER_TEST_ASSERT(not completion.await_suspend(std::coroutine_handle<>()));
+        HELPER_TEST_EQUALS(completion.await_resume(),2.0);
+
+        ConfigurationSearchCompletion failing;
+        bool has_thrown = false;
+        await_failure(failing, &has_thrown);
+        HELPER_TEST_ASSERT(not has_thrown);
+        failing.fail(std::make_exception_ptr(std::runtime_error("evaluation failed")));
+        HELPER_TEST_ASSERT(has_thrown);
+    }
+
+    void test_driver() {
+        auto space = make_bowl_space();
+        RandomEngine engine(6);
+        ConfigurationSearchEvolution evolution(16, 1);
+        ConfigurationSearchAskTellDriver driver(evolution.make_ask_tell(space, 300, engine));
+        std::atomic<size_t> num_finished(0);
+        size_t const num_coroutines = 1000;
+        {
+            TestEvaluationQueue queue(3);
+            for (size_t i=0; i<num_coroutines; ++i) evaluate_until_finished(&driver, &queue, &num_finished);
+            driver.wait();
+            while (num_finished.load() < num_coroutines) std::this_thread::yield();
+        }
+        HELPER_TEST_ASSERT(driver.is_finished());
+        HELPER_TEST_EQUALS(driver.num_waiting(),0);
+        HELPER_TEST_EQUALS(driver.best_cost(),bowl(driver.best()));
+        HELPER_TEST_ASSERT(driver.best_cost() <= 2.0);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_sampled());
+        HELPER_TEST_CALL(test_exhausted());
+        HELPER_TEST_CALL(test_evolution());
+        HELPER_TEST_CALL(test_local_search());
+        HELPER_TEST_CALL(test_surrogate());
+        HELPER_TEST_CALL(test_completion());
+        HELPER_TEST_CALL(test_driver());
+    }
+};
+
+int main() {
+    TestConfigurationSearchAskTell().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,138 @@
+/***************************************************************************
+ *            test_configuration_search_constraint.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "configuration_search_point.hpp"
+#include "configuration_search_point_range.hpp"
+#include "configuration_search_sampling.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchConstraint {
+  public:
+
+    ConfigurationPropertyPath order = ConfigurationPropertyPath("order");
+    ConfigurationPropertyPath maximum_order = ConfigurationPropertyPath("maximum_order");
+    ConfigurationPropertyPath use_subdivisions = ConfigurationPropertyPath("use_subdivisions");
+
+    ConfigurationSearchSpace make_space() {
+        ConfigurationSearchParameter op(order, true, List<int>({1, 2, 3, 4, 5, 6}));
+        ConfigurationSearchParameter mp(maximum_order, true, List<int>({1, 2, 3, 4, 5, 6}));
+        ConfigurationSearchParameter sp(use_subdivisions, false, List<int>({0, 1}));
+        ConfigurationSearchConstraint even("subdivisions need an even order", {use_subdivisions, order},
+                                           [](List<int> const& values) { return values[0] == 0 or values[1] % 2 == 0; });
+        return ConfigurationSearchSpace({op, mp, sp}, {ConfigurationSearchConstraint::less_or_equal(order, maximum_order), even});
+    }
+
+    bool satisfies_all(ConfigurationSearchPoint const& p) {
+        auto o = p.value(order), m = p.value(maximum_order), s = p.value(use_subdivisions);
+        return o <= m and (s == 0 or o % 2 == 0);
+    }
+
+    void test_constraint() {
+        auto constraint = ConfigurationSearchConstraint::less_or_equal(order, maximum_order);
+        HELPER_TEST_PRINT(constraint);
+        HELPER_TEST_EQUALS(constraint.paths().size(),2);
+        HELPER_TEST_ASSERT(constraint.is_satisfied_by({2, 3}));
+        HELPER_TEST_ASSERT(constraint.is_satisfied_by({3, 3}));
+        HELPER_TEST_ASSERT(not constraint.is_satisfied_by({4, 3}));
+        HELPER_TEST_FAIL(constraint.is_satisfied_by({4}));
+        HELPER_TEST_ASSERT(constraint == ConfigurationSearchConstraint::less_or_equal(order, maximum_order));
+        HELPER_TEST_ASSERT(not (constraint == ConfigurationSearchConstraint::less_or_equal(maximum_order, order)));
+        auto copy = constraint;
+        HELPER_TEST_ASSERT(copy == constraint);
+        ConfigurationSearchConstraint at_most("order at most maximum order", {order, maximum_order}, [](List<int> const& values) { return values[0] <= values[1]; });
+        ConfigurationSearchConstraint strictly("order at most maximum order", {order, maximum_order}, [](List<int> const& values) { return values[0] < values[1]; });
+        HELPER_TEST_ASSERT(at_most == at_most);
+        HELPER_TEST_ASSERT(not (at_most == strictly));
+    }
+
+    void test_space_constraints() {
+        auto space = make_space();
+        HELPER_TEST_EQUALS(space.constraints().size(),2);
+        HELPER_TEST_ASSERT(space.is_feasible(space.make_point(ParameterBindingsMap({{order,2},{maximum_order,2},{use_subdivisions,1}}))));
+        HELPER_TEST_ASSERT(not space.is_feasible(space.make_point(ParameterBindingsMap({{order,3},{maximum_order,2},{use_subdivisions,0}}))));
+        HELPER_TEST_ASSERT(not space.is_feasible(space.make_point(ParameterBindingsMap({{order,1},{maximum_order,2},{use_subdivisions,1}}))));
+        HELPER_TEST_ASSERT(not (space == ConfigurationSearchSpace(Set<ConfigurationSearchParameter>(space.parameters().begin(),space.parameters().end()))));
+        RandomEngine engine(3);
+        for (size_t i=0; i<100; ++i) HELPER_TEST_ASSERT(satisfies_all(space.initial_point(engine)));
+
+        ConfigurationSearchParameter op(order, true, List<int>({1, 2}));
+        ConfigurationSearchParameter mp(maximum_order, true, List<int>({1, 2}));
+        ConfigurationSearchSpace infeasible({op, mp}, {ConfigurationSearchConstraint("never", {order}, [](List<int> const&) { return false; })});
+        HELPER_TEST_FAIL(infeasible.initial_point());
+        HELPER_TEST_FAIL(ConfigurationSearchSpace({op}, {ConfigurationSearchConstraint::less_or_equal(order, maximum_order)}));
+    }
+
+    void test_shifting_constraints() {
+        auto space = make_space();
+        RandomEngine engine(7);
+        auto point = space.make_point(ParameterBindingsMap({{order,2},{maximum_order,2},{use_subdivisions,1}}));
+        for (size_t i=0; i<50; ++i) HELPER_TEST_ASSERT(satisfies_all(point.make_adjacent_shifted(engine)));
+        size_t num_feasible = 0;
+        for (size_t i=0; i<point.num_adjacent_points(); ++i) if (satisfies_all(point.make_adjacent(i))) ++num_feasible;
+        auto neighbours = point.neighbours();
+        HELPER_TEST_EQUALS(neighbours.size(),num_feasible);
+        for (auto const& p : neighbours) HELPER_TEST_ASSERT(satisfies_all(p));
+        auto shifted = point.make_random_shifted(20, engine);
+        HELPER_TEST_EQUALS(shifted.size(),20);
+        for (auto const& p : shifted) HELPER_TEST_ASSERT(satisfies_all(p));
+        auto extended = make_extended_set_by_shifting(shifted, 25, engine, 2);
+        HELPER_TEST_EQUALS(extended.size(),25);
+        for (auto const& p : extended) HELPER_TEST_ASSERT(satisfies_all(p));
+        for (auto const& p : make_sampled_points(space, 15, ConfigurationSearchSampling::LATIN_HYPERCUBE, engine)) HELPER_TEST_ASSERT(satisfies_all(p));
+    }
+
+    void test_enumeration_constraints() {
+        auto space = make_space();
+        size_t num_feasible = 0;
+        for (uint64_t i=0; i<space.total_points(); ++i) if (satisfies_all(space.point_at(i))) ++num_feasible;
+        for (auto ordering : {ConfigurationSearchPointOrdering::LEXICOGRAPHIC, ConfigurationSearchPointOrdering::GRAY}) {
+            size_t num_enumerated = 0;
+            for (auto const& chunk : ConfigurationSearchPointRange(space, ordering).partition(4)) {
+                for (auto const& p : chunk) {
+                    HELPER_TEST_ASSERT(satisfies_all(p));
+                    ++num_enumerated;
+                }
+            }
+            HELPER_TEST_EQUALS(num_enumerated,num_feasible);
+        }
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_constraint());
+        HELPER_TEST_CALL(test_space_constraints());
+        HELPER_TEST_CALL(test_shifting_constraints());
+        HELPER_TEST_CALL(test_enumeration_constraints());
+    }
+};
+
+int main() {
+    TestConfigurationSearchConstraint().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,102 @@
+/***************************************************************************
+ *            test_configuration_search_evaluation_cache.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <thread>
+#include "helper/test.hpp"
+#include "configuration_search_evaluation_cache.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchEvaluationCache {
+  public:
+
+    ConfigurationSearchSpace make_space() {
+        ConfigurationSearchParameter bp(ConfigurationPropertyPath("use_subdivisions"), false, List<int>({0, 1}));
+        ConfigurationSearchParameter mp(ConfigurationPropertyPath("sweep_threshold"), true, List<int>({3, 4, 5, 6, 7, 8}));
+        return ConfigurationSearchSpace({bp, mp});
+    }
+
+    void test_cache_lru() {
+        auto space = make_space();
+        auto p1 = space.make_point(List<int>({3, 0}));
+        auto p2 = space.make_point(List<int>({4, 0}));
+        auto p3 = space.make_point(List<int>({5, 1}));
+        ConfigurationSearchEvaluationCache cache(2, 1);
+        HELPER_TEST_EQUALS(cache.capacity(),2);
+        HELPER_TEST_ASSERT(not cache.find(p1).has_value());
+        cache.insert(p1, 1.5);
+        cache.insert(p2, 2.5);
+        HELPER_TEST_EQUALS(cache.find(p1).value(),1.5);
+        cache.insert(p3, 3.5);
+        HELPER_TEST_EQUALS(cache.size(),2);
+        HELPER_TEST_ASSERT(not cache.find(p2).has_value());
+        HELPER_TEST_EQUALS(cache.find(p3).value(),3.5);
+        cache.insert(p3, 4.5);
+        HELPER_TEST_EQUALS(cache.find(p3).value(),4.5);
+        HELPER_TEST_EQUALS(cache.size(),2);
+        auto statistics = cache.statistics();
+        HELPER_TEST_EQUALS(statistics.hits,3);
+        HELPER_TEST_EQUALS(statistics.misses,2);
+        HELPER_TEST_EQUALS(statistics.evictions,1);
+        HELPER_TEST_EQUALS(statistics.hit_rate(),0.6);
+        cache.clear();
+        HELPER_TEST_EQUALS(cache.size(),0);
+        HELPER_TEST_ASSERT(not cache.find(p1).has_value());
+        HELPER_TEST_FAIL(ConfigurationSearchEvaluationCache(0));
+    }
+
+    void test_cache_concurrent() {
+        auto space = make_space();
+        List<ConfigurationSearchPoint> points;
+        for (size_t i=0; i<space.total_points(); ++i) points.push_back(space.point_at(i));
+        ConfigurationSearchEvaluationCache cache(4*points.size(), 4);
+        List<std::thread> threads;
+        for (size_t t=0; t<4; ++t)
+            threads.emplace_back([&,t]{
+                for (size_t round=0; round<100; ++round)
+                    for (size_t i=t%2; i<points.size(); i+=2)
+                        if (not cache.find(points[i]).has_value()) cache.insert(points[i], static_cast<double>(i));
+            });
+        for (auto& thread : threads) thread.join();
+        HELPER_TEST_EQUALS(cache.size(),points.size());
+        for (size_t i=0; i<points.size(); ++i) HELPER_TEST_EQUALS(cache.find(points[i]).value(),static_cast<double>(i));
+        auto statistics = cache.statistics();
+        HELPER_TEST_EQUALS(statistics.hits+statistics.misses,4*100*points.size()/2+points.size());
+        HELPER_TEST_EQUALS(statistics.evictions,0);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_cache_lru());
+        HELPER_TEST_CALL(test_cache_concurrent());
+    }
+};
+
+int main() {
+    TestConfigurationSearchEvaluationCache().test();
+    return HELPER_TEST_FAILURES;
+}
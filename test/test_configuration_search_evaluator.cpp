@@ -0,0 +1,147 @@
+/***************************************************************************
+ *            test_configuration_search_evaluator.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "configuration_search_evaluator.hpp"
+#include "configuration_search_fixture.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchEvaluator {
+  public:
+
+    void test_pool() {
+        WorkStealingPool pool(3);
+        HELPER_TEST_EQUALS(pool.concurrency(),3);
+        List<std::atomic<size_t>> counts(100);
+        for (size_t batch=0; batch<2; ++batch)
+            pool.run(counts.size(),[&](size_t i){ ++counts[i]; });
+        for (auto const& c : counts) HELPER_TEST_EQUALS(c.load(),2);
+        pool.run(0,[](size_t){ throw std::runtime_error("unexpected"); });
+        HELPER_TEST_FAIL(pool.run(10,[](size_t i){ if (i == 7) throw std::runtime_error("failed"); }));
+        CancellationToken cancellation;
+        std::atomic<size_t> started(0);
+        cancellation.cancel();
+        pool.run(10,[&](size_t){ ++started; },cancellation);
+        HELPER_TEST_EQUALS(started.load(),0);
+        HELPER_TEST_FAIL(WorkStealingPool(0));
+    }
+
+    void test_run_concurrently() {
+        List<std::atomic<size_t>> counts(50);
+        for (size_t concurrency : {1u, 4u}) run_concurrently(counts.size(), concurrency, [&](size_t i){ ++counts[i]; });
+        for (auto const& c : counts) HELPER_TEST_EQUALS(c.load(),2);
+        std::atomic<size_t> nested(0);
+        run_concurrently(4, 4, [&](size_t){ run_concurrently(5, 4, [&](size_t){ ++nested; }); });
+        HELPER_TEST_EQUALS(nested.load(),20);
+        HELPER_TEST_FAIL(run_concurrently(10, 4, [](size_t i){ if (i == 3) throw std::runtime_error("failed"); }));
+        HELPER_TEST_FAIL(run_concurrently(10, 1, [](size_t i){ if (i == 3) throw std::runtime_error("failed"); }));
+        HELPER_TEST_FAIL(run_concurrently(10, 0, [](size_t){ }));
+        CancellationToken cancellation;
+        cancellation.cancel();
+        std::atomic<size_t> started(0);
+        run_concurrently(10, 4, [&](size_t){ ++started; }, cancellation);
+        HELPER_TEST_EQUALS(started.load(),0);
+    }
+
+    void test_evaluate() {
+        Configuration<TestSearchable> cfg;
+        auto space = cfg.search_space();
+        List<ConfigurationSearchPoint> points;
+        for (size_t i=0; i<space.total_points(); ++i) points.push_back(space.point_at(i));
+        auto cost = [](Configuration<TestSearchable> const& c) { return (c.order()-5)*(c.order()-5) + c.depth(); };
+        ConfigurationSearchEvaluator evaluator(4);
+        HELPER_TEST_EQUALS(evaluator.concurrency(),4);
+        auto evaluations = evaluator.evaluate(cfg,points,cost);
+        HELPER_TEST_EQUALS(evaluations.size(),points.size());
+        HELPER_TEST_EQUALS(evaluations.front().cost,1.0);
+        HELPER_TEST_EQUALS(evaluations.front().point,space.make_point(ParameterBindingsMap({{ConfigurationPropertyPath("order"),5},{ConfigurationPropertyPath("depth"),1}})));
+        for (size_t i=0; i<evaluations.size(); ++i) {
+            HELPER_TEST_EQUALS(evaluations[i].cost,cost(make_singleton(cfg,evaluations[i].point)));
+            HELPER_TEST_ASSERT(evaluations[i].duration.count() >= 0);
+            if (i > 0) HELPER_TEST_ASSERT(evaluations[i-1].cost <= evaluations[i].cost);
+        }
+        HELPER_TEST_EQUALS(evaluator.evaluate(cfg,Set<ConfigurationSearchPoint>(points.begin(),points.end()),cost).size(),points.size());
+        HELPER_TEST_EQUALS(evaluator.evaluate(cfg,List<ConfigurationSearchPoint>(),cost).size(),0);
+        auto point_evaluations = evaluator.evaluate(points,[&](ConfigurationSearchPoint const& p) { return cost(make_singleton(cfg,p)); });
+        HELPER_TEST_EQUALS(point_evaluations.size(),points.size());
+        for (size_t i=0; i<evaluations.size(); ++i) HELPER_TEST_EQUALS(point_evaluations[i].point,evaluations[i].point);
+    }
+
+    void test_evaluate_interrupted() {
+        Configuration<TestSearchable> cfg;
+        auto space = cfg.search_space();
+        List<ConfigurationSearchPoint> points;
+        for (size_t i=0; i<space.total_points(); ++i) points.push_back(space.point_at(i));
+        ConfigurationSearchEvaluator evaluator(1);
+        CancellationToken cancellation;
+        auto evaluations = evaluator.evaluate(cfg,points,[&](Configuration<TestSearchable> const& c) { cancellation.cancel(); return c.order(); },cancellation);
+        HELPER_TEST_EQUALS(evaluations.size(),1);
+        HELPER_TEST_FAIL(evaluator.evaluate(cfg,points,[](Configuration<TestSearchable> const& c) { if (c.order() == 3) throw std::runtime_error("failed"); return 0; }));
+        HELPER_TEST_EQUALS(evaluator.evaluate(cfg,points,[](Configuration<TestSearchable> const&) { return 0; }).size(),points.size());
+    }
+
+    void test_evaluate_cached() {
+        Configuration<TestSearchable> cfg;
+        auto space = cfg.search_space();
+        List<ConfigurationSearchPoint> points;
+        for (size_t i=0; i<space.total_points(); ++i) points.push_back(space.point_at(i));
+        std::atomic<size_t> evaluated(0);
+        auto base_cost = [](Configuration<TestSearchable> const& c) { return c.order() + c.depth(); };
+        auto cost = [&](Configuration<TestSearchable> const& c) { ++evaluated; return base_cost(c); };
+        ConfigurationSearchEvaluator evaluator(3, std::make_shared<ConfigurationSearchEvaluationCache>(points.size(),1));
+        auto first = evaluator.evaluate(cfg,List<ConfigurationSearchPoint>(points.begin(),points.begin()+10),cost);
+        HELPER_TEST_EQUALS(evaluated.load(),10);
+        for (auto const& e : first) HELPER_TEST_ASSERT(not e.is_cached);
+        auto second = evaluator.evaluate(cfg,points,cost);
+        HELPER_TEST_EQUALS(evaluated.load(),points.size());
+        HELPER_TEST_EQUALS(second.size(),points.size());
+        size_t num_cached = 0;
+        for (auto const& e : second) {
+            HELPER_TEST_EQUALS(e.cost,base_cost(make_singleton(cfg,e.point)));
+            if (e.is_cached) ++num_cached;
+        }
+        HELPER_TEST_EQUALS(num_cached,10);
+        auto statistics = evaluator.cache()->statistics();
+        HELPER_TEST_EQUALS(statistics.hits,10);
+        HELPER_TEST_EQUALS(statistics.misses,points.size());
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_pool());
+        HELPER_TEST_CALL(test_run_concurrently());
+        HELPER_TEST_CALL(test_evaluate());
+        HELPER_TEST_CALL(test_evaluate_interrupted());
+        HELPER_TEST_CALL(test_evaluate_cached());
+    }
+};
+
+int main() {
+    TestConfigurationSearchEvaluator().test();
+    return HELPER_TEST_FAILURES;
+}
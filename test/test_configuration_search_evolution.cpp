@@ -0,0 +1,159 @@
+/***************************************************************************
+ *            test_configuration_search_evolution.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "configuration_search_evolution.hpp"
+#include "configuration_search_fixture.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchEvolution {
+  public:
+
+    void test_crossover() {
+        Set<ConfigurationSearchParameter> parameters;
+        for (String component : {"integrator", "reconstructor"})
+            for (String property : {"order", "step"})
+                parameters.insert(ConfigurationSearchParameter(ConfigurationPropertyPath(component).append(property), true, List<int>({0, 1, 2, 3})));
+        parameters.insert(ConfigurationSearchParameter(ConfigurationPropertyPath("sweep"), true, List<int>({0, 1, 2, 3})));
+        parameters.insert(ConfigurationSearchParameter(ConfigurationPropertyPath("level"), true, List<int>({0, 1, 2, 3})));
+        ConfigurationSearchSpace space(parameters);
+        auto first = space.make_point(List<int>({0, 0, 0, 0, 0, 0}));
+        auto second = space.make_point(List<int>({3, 3, 3, 3, 3, 3}));
+        RandomEngine engine(1);
+        bool mixed_components = false;
+        for (size_t i=0; i<32; ++i) {
+            auto uniform = make_crossover(first, second, ConfigurationSearchCrossover::UNIFORM, engine);
+            for (auto c : uniform.coordinates()) HELPER_TEST_ASSERT(c == 0 or c == 3);
+            auto blocks = make_crossover(first, second, ConfigurationSearchCrossover::PATH_PREFIX, engine);
+            for (String component : {"integrator", "reconstructor"}) {
+                auto path = ConfigurationPropertyPath(component);
+                HELPER_TEST_EQUALS(blocks.value(ConfigurationPropertyPath(path).append("order")),blocks.value(ConfigurationPropertyPath(path).append("step")));
+            }
+            if (blocks.value(ConfigurationPropertyPath("level")) != blocks.value(ConfigurationPropertyPath("sweep"))) mixed_components = true;
+        }
+        HELPER_TEST_ASSERT(mixed_components);
+    }
+
+    void test_nested_crossover() {
+        ConfigurationPropertyPath stepper = ConfigurationPropertyPath("integrator").append("stepper");
+        ConfigurationPropertyPath order = ConfigurationPropertyPath(stepper).append("order");
+        ConfigurationPropertyPath step = ConfigurationPropertyPath(stepper).append("step");
+        ConfigurationPropertyPath tolerance = ConfigurationPropertyPath("integrator").append("tolerance");
+        ConfigurationPropertyPath sweep("sweep");
+        Set<ConfigurationSearchParameter> parameters;
+        for (auto const& path : {order, step, tolerance, sweep}) parameters.insert(ConfigurationSearchParameter(path, true, List<int>({0, 1, 2, 3})));
+        ConfigurationSearchSpace space(parameters);
+        auto first = space.make_point(List<int>({0, 0, 0, 0}));
+        auto second = space.make_point(List<int>({3, 3, 3, 3}));
+        RandomEngine engine(4);
+        bool mixed_root = false, mixed_integrator = false;
+        for (size_t i=0; i<32; ++i) {
+            auto top = make_crossover(first, second, ConfigurationSearchCrossover::PATH_PREFIX, engine);
+            HELPER_TEST_EQUALS(top.value(order),top.value(tolerance));
+            HELPER_TEST_EQUALS(top.value(step),top.value(tolerance));
+            if (top.value(sweep) != top.value(tolerance)) mixed_root = true;
+            auto nested = make_crossover(first, second, ConfigurationSearchCrossover::PATH_PREFIX, engine, 2);
+            HELPER_TEST_EQUALS(nested.value(order),nested.value(step));
+            if (nested.value(order) != nested.value(tolerance)) mixed_integrator = true;
+        }
+        HELPER_TEST_ASSERT(mixed_root);
+        HELPER_TEST_ASSERT(mixed_integrator);
+        HELPER_TEST_FAIL(make_crossover(first, second, ConfigurationSearchCrossover::PATH_PREFIX, engine, 0));
+        ConfigurationSearchEvolution evolution(8, 2);
+        HELPER_TEST_FAIL(evolution.set_crossover(ConfigurationSearchCrossover::PATH_PREFIX, 0));
+    }
+
+    void test_evolve() {
+        auto space = make_bowl_space();
+        RandomEngine engine(2);
+        ConfigurationSearchEvolution evolution(20, 30);
+        HELPER_TEST_EQUALS(evolution.population_size(),20);
+        HELPER_TEST_EQUALS(evolution.num_generations(),30);
+        evolution.set_concurrency(3);
+        evolution.set_num_elites(2);
+        evolution.set_tournament_size(3);
+        evolution.set_cache(std::make_shared<ConfigurationSearchEvaluationCache>(1000));
+        auto result = evolution.evolve(space, bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,0.0);
+        HELPER_TEST_EQUALS(result.best,space.make_point(List<int>({13, 4})));
+        HELPER_TEST_EQUALS(result.generation_best_costs.size(),31);
+        for (size_t i=1; i<result.generation_best_costs.size(); ++i)
+            HELPER_TEST_ASSERT(result.generation_best_costs[i] <= result.generation_best_costs[i-1]);
+        HELPER_TEST_ASSERT(result.num_evaluations <= 20+30*18);
+        HELPER_TEST_FAIL(evolution.set_num_elites(20));
+        HELPER_TEST_FAIL(evolution.set_mutation_probability(1.5));
+    }
+
+    void test_evolve_constrained() {
+        List<int> values;
+        for (int i=0; i<=20; ++i) values.push_back(i);
+        ConfigurationPropertyPath x("x"), y("y");
+        ConfigurationSearchSpace space({ConfigurationSearchParameter(x, true, values), ConfigurationSearchParameter(y, true, values)},
+                                       {ConfigurationSearchConstraint::less_or_equal(y, x)});
+        RandomEngine engine(3);
+        ConfigurationSearchEvolution evolution(16, 20);
+        evolution.set_crossover(ConfigurationSearchCrossover::PATH_PREFIX);
+        auto result = evolution.evolve(space, bowl, engine);
+        HELPER_TEST_ASSERT(space.is_feasible(result.best));
+        HELPER_TEST_EQUALS(result.best,space.make_point(List<int>({13, 4})));
+
+        CancellationToken cancellation;
+        result = evolution.evolve(space, [&](ConfigurationSearchPoint const& p) { cancellation.cancel(); return bowl(p); }, engine, cancellation);
+        HELPER_TEST_EQUALS(result.generation_best_costs.size(),1);
+        HELPER_TEST_EQUALS(result.num_evaluations,16);
+
+        CancellationToken midway;
+        size_t num_calls = 0;
+        result = evolution.evolve(space, [&](ConfigurationSearchPoint const& p) { if (++num_calls == 20) midway.cancel(); return bowl(p); }, engine, midway);
+        HELPER_TEST_EQUALS(result.generation_best_costs.size(),1);
+        HELPER_TEST_EQUALS(result.num_evaluations,20);
+        HELPER_TEST_EQUALS(result.best_cost,result.generation_best_costs.front());
+    }
+
+    void test_evolve_configuration() {
+        Configuration<TestSearchable> cfg;
+        RandomEngine engine(4);
+        ConfigurationSearchEvolution evolution(8, 10);
+        auto result = evolution.evolve(cfg, configuration_bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,1.0);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_crossover());
+        HELPER_TEST_CALL(test_nested_crossover());
+        HELPER_TEST_CALL(test_evolve());
+        HELPER_TEST_CALL(test_evolve_constrained());
+        HELPER_TEST_CALL(test_evolve_configuration());
+    }
+};
+
+int main() {
+    TestConfigurationSearchEvolution().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,136 @@
+/***************************************************************************
+ *            test_configuration_search_local_search.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "configuration_search_local_search.hpp"
+#include "configuration_search_fixture.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchLocalSearch {
+  public:
+
+    void test_greedy() {
+        auto space = make_bowl_space();
+        RandomEngine engine(1);
+        ConfigurationSearchLocalSearch search(GreedyAcceptance(), 200);
+        auto result = search.search(space, bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,0.0);
+        HELPER_TEST_EQUALS(result.best,space.make_point(List<int>({13, 4})));
+        HELPER_TEST_EQUALS(result.chain_best_costs.size(),1);
+        HELPER_TEST_EQUALS(result.num_evaluations,201);
+
+        search.set_tabu_tenure(10);
+        search.set_num_chains(3);
+        search.set_cache(std::make_shared<ConfigurationSearchEvaluationCache>(1000));
+        result = search.search(space, bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,0.0);
+        HELPER_TEST_EQUALS(result.chain_best_costs,List<double>(3,0.0));
+        HELPER_TEST_ASSERT(result.num_evaluations <= space.total_points());
+    }
+
+    void test_annealing() {
+        auto space = make_bowl_space();
+        RandomEngine engine(2);
+        ConfigurationSearchLocalSearch search(AnnealingAcceptance(10.0, 0.98), 400);
+        search.set_num_chains(4);
+        search.set_restart_after(50);
+        auto result = search.search(space, bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,0.0);
+        HELPER_TEST_EQUALS(result.chain_best_costs.size(),4);
+        HELPER_TEST_FAIL(AnnealingAcceptance(0.0, 0.5));
+        HELPER_TEST_FAIL(AnnealingAcceptance(1.0, 1.5));
+    }
+
+    void test_tempering() {
+        auto space = make_bowl_space();
+        RandomEngine engine(3);
+        ConfigurationSearchLocalSearch search(AnnealingAcceptance(1.0, 1.0), 300);
+        search.set_num_chains(4);
+        search.set_tempering(4.0, 10);
+        auto result = search.search(space, bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,0.0);
+        ConfigurationSearchLocalSearch greedy(GreedyAcceptance(), 10);
+        greedy.set_tempering(2.0, 5);
+        HELPER_TEST_FAIL(greedy.search(space, bowl));
+    }
+
+    void test_interruption() {
+        auto space = make_bowl_space();
+        for (bool tempering : {false, true}) {
+            ConfigurationSearchLocalSearch search(AnnealingAcceptance(1.0, 0.99), 1000);
+            search.set_num_chains(3);
+            if (tempering) search.set_tempering(2.0, 5);
+            std::atomic<size_t> calls(0);
+            HELPER_TEST_FAIL(search.search(space, [&](ConfigurationSearchPoint const& p) {
+                if (++calls == 20) throw std::runtime_error("failed");
+                return bowl(p);
+            }));
+            CancellationToken cancellation;
+            calls = 0;
+            auto result = search.search(space, [&](ConfigurationSearchPoint const& p) {
+                if (++calls == 20) cancellation.cancel();
+                return bowl(p);
+            }, RandomEngine::thread_engine(), cancellation);
+            HELPER_TEST_ASSERT(result.num_evaluations < 100);
+        }
+    }
+
+    void test_non_finite_costs() {
+        auto space = make_bowl_space();
+        RandomEngine engine(5);
+        ConfigurationSearchLocalSearch search(AnnealingAcceptance(1.0, 0.9), 20);
+        search.set_num_chains(2);
+        auto result = search.search(space, [](ConfigurationSearchPoint const&) { return std::numeric_limits<double>::infinity(); }, engine);
+        HELPER_TEST_EQUALS(result.best_cost,std::numeric_limits<double>::infinity());
+        result = search.search(space, [](ConfigurationSearchPoint const&) { return std::numeric_limits<double>::quiet_NaN(); }, engine);
+        HELPER_TEST_ASSERT(std::isnan(result.best_cost));
+    }
+
+    void test_configuration() {
+        Configuration<TestSearchable> cfg;
+        RandomEngine engine(4);
+        ConfigurationSearchLocalSearch search(GreedyAcceptance(), 50);
+        auto result = search.search(cfg, configuration_bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,1.0);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_greedy());
+        HELPER_TEST_CALL(test_annealing());
+        HELPER_TEST_CALL(test_tempering());
+        HELPER_TEST_CALL(test_interruption());
+        HELPER_TEST_CALL(test_non_finite_costs());
+        HELPER_TEST_CALL(test_configuration());
+    }
+};
+
+int main() {
+    TestConfigurationSearchLocalSearch().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -28,6 +28,7 @@
 
 #include "helper/test.hpp"
 #include "configuration_search_point.hpp"
+#include "configuration_search_point_set.hpp"
 #include "configuration_search_space.hpp"
 
 using namespace ProNest;
@@ -82,6 +83,36 @@ class TestConfigurationSearchParameter {
         ConfigurationSearchPoint point = space.make_point(bindings);
         HELPER_TEST_PRINT(point);
         HELPER_TEST_PRINT(point.space());
+        HELPER_TEST_EQUALS(point.coordinates(),List<int>({5, 1}));
+        HELPER_TEST_EQUALS(point.value(use_subdivisions),1);
+        HELPER_TEST_EQUALS(point.value(space.index(sweep_threshold)),5);
+        HELPER_TEST_EQUALS(point.bindings(),bindings);
+        HELPER_TEST_EQUAL(space.make_point(List<int>({5, 1})),point);
+        HELPER_TEST_FAIL(space.make_point(List<int>({5})));
+        auto point_copy = point;
+        HELPER_TEST_ASSERT(&point_copy.space().parameters() == &space.parameters());
+    }
+
+    void test_parameter_point_encoding() {
+        ConfigurationPropertyPath use_subdivisions("use_subdivisions");
+        ConfigurationPropertyPath sweep_threshold("sweep_threshold");
+        ConfigurationPropertyPath level("level");
+        ConfigurationSearchParameter bp(use_subdivisions, false, List<int>({0, 1}));
+        ConfigurationSearchParameter mp(sweep_threshold, true, List<int>({3, 4, 5}));
+        ConfigurationSearchParameter ep(level, false, List<int>({2, 7, 4}));
+        ConfigurationSearchSpace space({bp, mp, ep});
+        HELPER_TEST_EQUALS(ep.index_of(4),2);
+        HELPER_TEST_FAIL(mp.index_of(6));
+        HELPER_TEST_EQUALS(space.point_at(0).coordinates(),List<int>({2, 3, 0}));
+        HELPER_TEST_EQUALS(space.index_of(space.make_point({{use_subdivisions, 1}, {sweep_threshold, 4}, {level, 7}})),9);
+        Set<ConfigurationSearchPoint> points;
+        for (uint64_t i=0; i<space.total_points(); ++i) {
+            auto point = space.point_at(i);
+            HELPER_TEST_EQUALS(space.index_of(point),i);
+            points.insert(point);
+        }
+        HELPER_TEST_EQUALS(points.size(),space.total_points());
+        HELPER_TEST_FAIL(space.point_at(space.total_points()));
     }
 
     void test_parameter_point_equality() {
@@ -144,6 +175,75 @@ class TestConfigurationSearchParameter {
         HELPER_TEST_EQUALS(points.size(),space.total_points());
     }
 
+    void test_parameter_point_set() {
+        ConfigurationSearchParameter bp(ConfigurationPropertyPath("use_subdivisions"), false, List<int>({0, 1}));
+        ConfigurationSearchParameter mp(ConfigurationPropertyPath("sweep_threshold"), true, List<int>({3, 4, 5, 6, 7}));
+        ConfigurationSearchSpace space({bp, mp});
+        auto p1 = space.make_point(List<int>({5, 1}));
+        auto p2 = space.make_point(List<int>({5, 0}));
+        HELPER_TEST_EQUALS(p1.hash(),space.make_point(List<int>({5, 1})).hash());
+
+        ConfigurationSearchPointSet points;
+        HELPER_TEST_ASSERT(points.empty());
+        HELPER_TEST_ASSERT(points.insert(p1));
+        HELPER_TEST_ASSERT(points.insert(p2));
+        HELPER_TEST_ASSERT(not points.insert(space.make_point(List<int>({5, 1}))));
+        HELPER_TEST_EQUALS(points.size(),2);
+        HELPER_TEST_EQUALS(points[0],p1);
+        HELPER_TEST_EQUALS(points[1],p2);
+        HELPER_TEST_ASSERT(points.contains(p2));
+        HELPER_TEST_ASSERT(not points.contains(space.make_point(List<int>({6, 0}))));
+        HELPER_TEST_FAIL(points[2]);
+        HELPER_TEST_ASSERT(points.to_set() == Set<ConfigurationSearchPoint>({p1, p2}));
+        HELPER_TEST_EQUALS(ConfigurationSearchPointSet(points.to_set()).size(),2);
+
+        auto shifted = p1.make_random_shifted(space.total_points());
+        HELPER_TEST_EQUALS(shifted.size(),space.total_points());
+        HELPER_TEST_FAIL(p1.make_random_shifted(space.total_points()+1));
+    }
+
+    void test_parameter_point_adjacent() {
+        ConfigurationSearchParameter bp(ConfigurationPropertyPath("use_subdivisions"), false, List<int>({0, 1}));
+        ConfigurationSearchParameter mp(ConfigurationPropertyPath("sweep_threshold"), true, List<int>({3, 4, 5, 6, 7, 8}));
+        ConfigurationSearchParameter ep(ConfigurationPropertyPath("level"), false, List<int>({2, 7, 4}));
+        ConfigurationSearchSpace space({bp, mp, ep});
+        auto point = space.make_point(List<int>({7, 5, 1}));
+        HELPER_TEST_EQUALS(point.num_adjacent_points(),5);
+        Set<ConfigurationSearchPoint> adjacents;
+        for (size_t i=0; i<point.num_adjacent_points(); ++i) {
+            auto adjacent = point.make_adjacent(i);
+            HELPER_TEST_EQUALS(point.distance(adjacent),1);
+            adjacents.insert(adjacent);
+        }
+        HELPER_TEST_EQUALS(adjacents.size(),5);
+        HELPER_TEST_FAIL(point.make_adjacent(5));
+
+        auto neighbours = point.neighbours();
+        HELPER_TEST_EQUALS(neighbours.size(),5);
+        size_t index = 0;
+        for (auto const& neighbour : neighbours) HELPER_TEST_EQUALS(neighbour,point.make_adjacent(index++));
+        HELPER_TEST_EQUALS(index,5);
+        auto sum = [](ConfigurationSearchPoint const& p) { return p.coordinates()[0] + p.coordinates()[1] + p.coordinates()[2]; };
+        auto sums = neighbours.evaluate(sum);
+        HELPER_TEST_EQUALS(sums.size(),5);
+        for (size_t i=0; i<sums.size(); ++i) HELPER_TEST_EQUALS(sums[i],sum(neighbours[i]));
+        HELPER_TEST_ASSERT(neighbours.evaluate(sum,3) == sums);
+
+        auto with_adjacents = make_extended_set_by_shifting({point},6);
+        adjacents.insert(point);
+        HELPER_TEST_ASSERT(with_adjacents == adjacents);
+
+        RandomEngine a(3), b(3);
+        HELPER_TEST_ASSERT(make_extended_set_by_shifting({point},20,a) == make_extended_set_by_shifting({point},20,b));
+        for (size_t concurrency : {1u, 4u}) {
+            auto points = make_extended_set_by_shifting({point},20,a,concurrency);
+            HELPER_TEST_EQUALS(points.size(),20);
+            HELPER_TEST_ASSERT(points.contains(point));
+            auto all_points = make_extended_set_by_shifting(points,space.total_points(),a,concurrency);
+            HELPER_TEST_EQUALS(all_points.size(),space.total_points());
+        }
+    }
+
     void test_parameter_point_adjacent_set_shift() {
         ConfigurationPropertyPath use_subdivisions("use_subdivisions");
         ConfigurationPropertyPath sweep_threshold("sweep_threshold");
@@ -182,10 +282,13 @@ class TestConfigurationSearchParameter {
         HELPER_TEST_CALL(test_metric_parameter_shift());
         HELPER_TEST_CALL(test_parameter_space());
         HELPER_TEST_CALL(test_parameter_point_creation());
+        HELPER_TEST_CALL(test_parameter_point_encoding());
         HELPER_TEST_CALL(test_parameter_point_equality());
         HELPER_TEST_CALL(test_parameter_point_distance());
         HELPER_TEST_CALL(test_parameter_point_adjacent_shift());
         HELPER_TEST_CALL(test_parameter_point_random_shift());
+        HELPER_TEST_CALL(test_parameter_point_set());
+        HELPER_TEST_CALL(test_parameter_point_adjacent());
         HELPER_TEST_CALL(test_parameter_point_adjacent_set_shift());
     }
 };
@@ -0,0 +1,104 @@
+/***************************************************************************
+ *            test_configuration_search_point_range.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "configuration_search_point_range.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchPointRange {
+  public:
+
+    ConfigurationSearchSpace make_space() {
+        ConfigurationSearchParameter bp(ConfigurationPropertyPath("use_subdivisions"), false, List<int>({0, 1}));
+        ConfigurationSearchParameter mp(ConfigurationPropertyPath("sweep_threshold"), true, List<int>({3, 4, 5}));
+        ConfigurationSearchParameter ep(ConfigurationPropertyPath("level"), false, List<int>({2, 7, 4}));
+        return ConfigurationSearchSpace({bp, mp, ep});
+    }
+
+    void test_lexicographic() {
+        auto space = make_space();
+        ConfigurationSearchPointRange range(space);
+        HELPER_TEST_EQUALS(range.size(),space.total_points());
+        uint64_t index = 0;
+        for (auto const& point : range) {
+            HELPER_TEST_EQUALS(space.index_of(point),index);
+            ++index;
+        }
+        HELPER_TEST_EQUALS(index,space.total_points());
+    }
+
+    void test_gray() {
+        auto space = make_space();
+        ConfigurationSearchPointRange range(space, ConfigurationSearchPointOrdering::GRAY);
+        Set<ConfigurationSearchPoint> points;
+        List<ConfigurationSearchPoint> sequence;
+        for (auto const& point : range) {
+            points.insert(point);
+            sequence.push_back(point);
+        }
+        HELPER_TEST_PRINT(sequence);
+        HELPER_TEST_EQUALS(points.size(),space.total_points());
+        for (size_t i=1; i<sequence.size(); ++i)
+            HELPER_TEST_EQUALS(sequence[i-1].distance(sequence[i]),1);
+        HELPER_TEST_EQUAL(range.point_at(5),sequence[5]);
+    }
+
+    void test_partition() {
+        auto space = make_space();
+        for (auto ordering : {ConfigurationSearchPointOrdering::LEXICOGRAPHIC, ConfigurationSearchPointOrdering::GRAY}) {
+            ConfigurationSearchPointRange range(space, ordering);
+            List<ConfigurationSearchPoint> whole;
+            for (auto const& point : range) whole.push_back(point);
+            auto chunks = range.partition(5);
+            HELPER_TEST_EQUALS(chunks.size(),5);
+            List<ConfigurationSearchPoint> joined;
+            for (auto const& chunk : chunks) {
+                HELPER_TEST_ASSERT(chunk.size() == 3 or chunk.size() == 4);
+                for (auto const& point : chunk) joined.push_back(point);
+            }
+            HELPER_TEST_EQUALS(joined.size(),whole.size());
+            HELPER_TEST_ASSERT(joined == whole);
+            auto empty_chunks = ConfigurationSearchPointRange(space, ordering, 0, 2).partition(3);
+            HELPER_TEST_ASSERT(empty_chunks[2].empty());
+            HELPER_TEST_ASSERT(empty_chunks[2].begin() == empty_chunks[2].end());
+        }
+        HELPER_TEST_FAIL(ConfigurationSearchPointRange(space, ConfigurationSearchPointOrdering::GRAY, 0, space.total_points()+1));
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_lexicographic());
+        HELPER_TEST_CALL(test_gray());
+        HELPER_TEST_CALL(test_partition());
+    }
+};
+
+int main() {
+    TestConfigurationSearchPointRange().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,97 @@
+/***************************************************************************
+ *            test_configuration_search_population.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "configuration_search_population.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchPopulation {
+  public:
+
+    ConfigurationSearchSpace make_space() {
+        ConfigurationSearchParameter bp(ConfigurationPropertyPath("use_subdivisions"), false, List<int>({0, 1}));
+        ConfigurationSearchParameter mp(ConfigurationPropertyPath("sweep_threshold"), true, List<int>({3, 4, 5, 6, 7, 8}));
+        ConfigurationSearchParameter ep(ConfigurationPropertyPath("level"), false, List<int>({2, 7, 4}));
+        return ConfigurationSearchSpace({bp, mp, ep});
+    }
+
+    void test_distances() {
+        auto space = make_space();
+        List<ConfigurationSearchPoint> points;
+        RandomEngine engine(11);
+        for (size_t i=0; i<13; ++i) points.push_back(space.initial_point(engine));
+        ConfigurationSearchPopulation population(points);
+        HELPER_TEST_EQUALS(population.size(),13);
+        HELPER_TEST_EQUALS(population.point(4),points[4]);
+        auto matrix = population.distance_matrix();
+        HELPER_TEST_EQUALS(matrix.size(),13*13);
+        for (size_t i=0; i<points.size(); ++i) {
+            auto row = population.distances_from(i);
+            for (size_t j=0; j<points.size(); ++j) {
+                HELPER_TEST_EQUALS(matrix[i*points.size()+j],points[i].distance(points[j]));
+                HELPER_TEST_EQUALS(row[j],matrix[i*points.size()+j]);
+            }
+        }
+        auto nearest = population.nearest_distances(3);
+        HELPER_TEST_EQUALS(nearest.size(),13);
+        for (auto const& n : nearest) {
+            HELPER_TEST_EQUALS(n.size(),3);
+            HELPER_TEST_ASSERT(n[0] <= n[1] and n[1] <= n[2]);
+        }
+        HELPER_TEST_FAIL(population.nearest_distances(13));
+    }
+
+    void test_diversity() {
+        auto space = make_space();
+        auto p1 = space.make_point(List<int>({2, 3, 0}));
+        auto p2 = space.make_point(List<int>({7, 8, 1}));
+        auto p3 = space.make_point(List<int>({2, 4, 0}));
+        HELPER_TEST_EQUALS(ConfigurationSearchPopulation({p1}).mean_distance(),0.0);
+        ConfigurationSearchPopulation extremes({p1, p2});
+        HELPER_TEST_EQUALS(extremes.maximum_distance(),7);
+        HELPER_TEST_EQUALS(extremes.diversity(),1.0);
+        ConfigurationSearchPopulation population({p1, p2, p3});
+        HELPER_TEST_EQUALS(population.mean_distance(),(7.0+1.0+6.0)/3);
+        auto crowding = population.crowding(1);
+        HELPER_TEST_EQUALS(crowding[0],1.0);
+        HELPER_TEST_EQUALS(crowding[1],6.0);
+        HELPER_TEST_EQUALS(crowding[2],1.0);
+        HELPER_TEST_ASSERT(ConfigurationSearchPopulation({p1, p3}).diversity() < population.diversity());
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_distances());
+        HELPER_TEST_CALL(test_diversity());
+    }
+};
+
+int main() {
+    TestConfigurationSearchPopulation().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,177 @@
+/***************************************************************************
+ *            test/test_configuration_search_process_pool.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <unistd.h>
+#include <signal.h>
+#include <memory>
+#include "helper/test.hpp"
+#include "configuration_search_process_pool.hpp"
+#include "configuration_search_fixture.hpp"
+
+using namespace ProNest;
+
+//! \brief Incremented by the cost, to check that the evaluations do not affect the coordinator
+static int num_calls = 0;
+
+class TestConfigurationSearchProcessPool {
+  public:
+
+    ConfigurationSearchSpace make_space() {
+        List<int> values;
+        for (int i=-300; i<=300; i+=3) values.push_back(i);
+        ConfigurationSearchParameter xp(ConfigurationPropertyPath("x"), true, values);
+        ConfigurationSearchParameter yp(ConfigurationPropertyPath("y"), false, List<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+        return ConfigurationSearchSpace({xp, yp});
+    }
+
+    static double cost(ConfigurationSearchPoint const& p) {
+        ++num_calls;
+        if (p.value(1) == 5) throw std::runtime_error("unsupported");
+        if (p.value(1) == 7) ::kill(::getpid(), SIGKILL);
+        return p.value(0)*10 + p.value(1);
+    }
+
+    void test_encoding() {
+        auto space = make_space();
+        for (auto const& coordinates : {List<int>({0, 0}), List<int>({-300, 7}), List<int>({300, 3})}) {
+            auto point = space.make_point(coordinates);
+            auto bytes = encode_point(point);
+            HELPER_TEST_ASSERT(bytes.size() <= 4);
+            HELPER_TEST_EQUALS(decode_point(space, bytes),point);
+        }
+        auto bytes = encode_point(space.make_point(List<int>({3, 1})));
+        HELPER_TEST_EQUALS(bytes.size(),3);
+        bytes.push_back(0);
+        HELPER_TEST_FAIL(decode_point(space, bytes));
+        HELPER_TEST_FAIL(decode_point(space, List<uint8_t>({1, 0})));
+    }
+
+    void test_evaluate() {
+        auto space = make_space();
+        ConfigurationSearchProcessPool pool(space, cost, 3);
+        HELPER_TEST_EQUALS(pool.num_workers(),3);
+        List<ConfigurationSearchPoint> points;
+        for (int x=-30; x<=30; x+=3)
+            for (int y : {0, 1, 2, 3}) points.push_back(space.make_point(List<int>({x, y})));
+        size_t num_streamed = 0;
+        auto evaluations = pool.evaluate(points, [&](ConfigurationSearchProcessEvaluation const&) { ++num_streamed; });
+        HELPER_TEST_EQUALS(evaluations.size(),points.size());
+        HELPER_TEST_EQUALS(num_streamed,points.size());
+        for (size_t i=0; i<points.size(); ++i) {
+            HELPER_TEST_EQUALS(evaluations[i].point,points[i]);
+            HELPER_TEST_ASSERT(evaluations[i].cost.has_value());
+            HELPER_TEST_EQUALS(*evaluations[i].cost,points[i].value(0)*10 + points[i].value(1));
+        }
+        HELPER_TEST_EQUALS(num_calls,0);
+        HELPER_TEST_EQUALS(pool.num_restarts(),0);
+    }
+
+    void test_failures() {
+        auto space = make_space();
+        ConfigurationSearchProcessPool pool(space, cost, 2);
+        List<ConfigurationSearchPoint> points;
+        for (int y=0; y<8; ++y)
+            for (int x : {0, 3}) points.push_back(space.make_point(List<int>({x, y})));
+        auto evaluations = pool.evaluate(points);
+        HELPER_TEST_EQUALS(evaluations.size(),points.size());
+        for (auto const& e : evaluations) {
+            if (e.point.value(1) == 5) {
+                HELPER_TEST_ASSERT(not e.cost.has_value());
+                HELPER_TEST_EQUALS(e.error,"unsupported");
+                HELPER_TEST_ASSERT(not e.is_crashed);
+            } else if (e.point.value(1) == 7) {
+                HELPER_TEST_ASSERT(not e.cost.has_value());
+                HELPER_TEST_ASSERT(e.is_crashed);
+            } else {
+                HELPER_TEST_ASSERT(e.cost.has_value());
+            }
+        }
+        HELPER_TEST_EQUALS(pool.num_restarts(),2);
+        auto again = pool.evaluate({space.make_point(List<int>({6, 1}))});
+        HELPER_TEST_EQUALS(*again.front().cost,61.0);
+    }
+
+    void test_malformed_request() {
+        auto space = make_space();
+        ConfigurationSearchProcessPool pool(space, cost, 1);
+        ConfigurationSearchParameter zp(ConfigurationPropertyPath("z"), true, List<int>({0, 1}));
+        ConfigurationSearchSpace other({space.parameters()[0], space.parameters()[1], zp});
+        // The worker fails to decode a point with the wrong dimension
+        auto evaluations = pool.evaluate({other.make_point(List<int>({3, 1, 0}))});
+        HELPER_TEST_EQUALS(evaluations.size(),1);
+        HELPER_TEST_ASSERT(evaluations.front().is_crashed);
+        HELPER_TEST_EQUALS(pool.num_restarts(),1);
+        HELPER_TEST_EQUALS(*pool.evaluate({space.make_point(List<int>({6, 1}))}).front().cost,61.0);
+    }
+
+    void test_cancellation() {
+        auto space = make_space();
+        ConfigurationSearchProcessPool pool(space, cost, 1);
+        List<ConfigurationSearchPoint> points;
+        for (int x=0; x<30; x+=3) points.push_back(space.make_point(List<int>({x, 0})));
+        CancellationToken cancellation;
+        auto evaluations = pool.evaluate(points, [&](ConfigurationSearchProcessEvaluation const&) { cancellation.cancel(); }, cancellation);
+        HELPER_TEST_EQUALS(evaluations.size(),1);
+    }
+
+    void test_overlapping_pools() {
+        auto space = make_space();
+        auto point = space.make_point(List<int>({3, 2}));
+        auto first = std::make_unique<ConfigurationSearchProcessPool>(space, cost, 2);
+        auto second = std::make_unique<ConfigurationSearchProcessPool>(space, cost, 2);
+        auto const start = std::chrono::steady_clock::now();
+        first.reset();
+        HELPER_TEST_ASSERT(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(400));
+        HELPER_TEST_EQUALS(*second->evaluate({point}).front().cost,32.0);
+        second.reset();
+    }
+
+    void test_configuration() {
+        Configuration<TestSearchable> cfg;
+        ConfigurationSearchProcessPool pool(cfg, configuration_bowl, 2);
+        auto space = cfg.search_space();
+        auto point = space.make_point(List<int>({2, 5}));
+        auto evaluations = pool.evaluate({point});
+        HELPER_TEST_EQUALS(*evaluations.front().cost,configuration_bowl(ConfigurationSingletonMaker<TestSearchable>(cfg, space).make(point)));
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_encoding());
+        HELPER_TEST_CALL(test_evaluate());
+        HELPER_TEST_CALL(test_failures());
+        HELPER_TEST_CALL(test_malformed_request());
+        HELPER_TEST_CALL(test_cancellation());
+        HELPER_TEST_CALL(test_overlapping_pools());
+        HELPER_TEST_CALL(test_configuration());
+    }
+};
+
+int main() {
+    TestConfigurationSearchProcessPool().test();
+    return HELPER_TEST_FAILURES;
+}
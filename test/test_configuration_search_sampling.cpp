@@ -0,0 +1,99 @@
+/***************************************************************************
+ *            test_configuration_search_sampling.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "configuration_search_sampling.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchSampling {
+  public:
+
+    ConfigurationSearchSpace make_space() {
+        ConfigurationSearchParameter bp(ConfigurationPropertyPath("use_subdivisions"), false, List<int>({0, 1}));
+        ConfigurationSearchParameter mp(ConfigurationPropertyPath("sweep_threshold"), true, List<int>({3, 4, 5, 6, 7, 8, 9, 10}));
+        ConfigurationSearchParameter ep(ConfigurationPropertyPath("level"), false, List<int>({2, 7, 4}));
+        return ConfigurationSearchSpace({bp, mp, ep});
+    }
+
+    List<size_t> value_counts(List<ConfigurationSearchPoint> const& points, ConfigurationSearchSpace const& space, ConfigurationPropertyPath const& path) {
+        auto const& parameter = space.parameter(path);
+        List<size_t> result(parameter.values().size(),0);
+        for (auto const& p : points) ++result[parameter.index_of(p.value(space.index(path)))];
+        return result;
+    }
+
+    void test_sampling_distinct() {
+        auto space = make_space();
+        for (auto sampling : {ConfigurationSearchSampling::UNIFORM, ConfigurationSearchSampling::LATIN_HYPERCUBE,
+                              ConfigurationSearchSampling::HALTON, ConfigurationSearchSampling::SOBOL}) {
+            RandomEngine engine1(5), engine2(5);
+            auto points = make_sampled_points(space, 20, sampling, engine1);
+            HELPER_TEST_EQUALS(points.size(),20);
+            HELPER_TEST_EQUALS(Set<ConfigurationSearchPoint>(points.begin(),points.end()).size(),20);
+            HELPER_TEST_ASSERT(points == make_sampled_points(space, 20, sampling, engine2));
+            auto all = make_sampled_points(space, space.total_points(), sampling, engine1);
+            HELPER_TEST_EQUALS(Set<ConfigurationSearchPoint>(all.begin(),all.end()).size(),space.total_points());
+        }
+        HELPER_TEST_EQUALS(make_sampled_points(space, 0, ConfigurationSearchSampling::SOBOL).size(),0);
+        HELPER_TEST_FAIL(make_sampled_points(space, space.total_points()+1, ConfigurationSearchSampling::HALTON));
+    }
+
+    void test_sampling_stratified() {
+        auto space = make_space();
+        ConfigurationPropertyPath metric("sweep_threshold"), non_metric("level");
+        RandomEngine engine(17);
+        for (auto sampling : {ConfigurationSearchSampling::LATIN_HYPERCUBE, ConfigurationSearchSampling::SOBOL}) {
+            auto points = make_sampled_points(space, 8, sampling, engine);
+            HELPER_TEST_EQUALS(value_counts(points, space, metric),List<size_t>(8,1));
+        }
+        auto points = make_sampled_points(space, 6, ConfigurationSearchSampling::LATIN_HYPERCUBE, engine);
+        HELPER_TEST_EQUALS(value_counts(points, space, non_metric),List<size_t>(3,2));
+        HELPER_TEST_EQUALS(value_counts(points, space, ConfigurationPropertyPath("use_subdivisions")),List<size_t>(2,3));
+    }
+
+    void test_sampling_sobol_dimension() {
+        Set<ConfigurationSearchParameter> parameters;
+        for (size_t i=0; i<=SOBOL_MAXIMUM_DIMENSION; ++i)
+            parameters.insert(ConfigurationSearchParameter(ConfigurationPropertyPath("p"+std::to_string(i)), true, List<int>({0, 1})));
+        ConfigurationSearchSpace space(parameters);
+        HELPER_TEST_FAIL(make_sampled_points(space, 4, ConfigurationSearchSampling::SOBOL));
+        HELPER_TEST_EQUALS(make_sampled_points(space, 4, ConfigurationSearchSampling::HALTON).size(),4);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_sampling_distinct());
+        HELPER_TEST_CALL(test_sampling_stratified());
+        HELPER_TEST_CALL(test_sampling_sobol_dimension());
+    }
+};
+
+int main() {
+    TestConfigurationSearchSampling().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,134 @@
+/***************************************************************************
+ *            test_configuration_search_scheduler.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <mutex>
+#include "helper/test.hpp"
+#include "configuration_search_scheduler.hpp"
+#include "configuration_search_fixture.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchScheduler {
+  public:
+
+    void test_budgets() {
+        ConfigurationSearchScheduler scheduler(1, 27);
+        HELPER_TEST_EQUALS(scheduler.num_brackets(),4);
+        HELPER_TEST_EQUALS(scheduler.bracket_size(3),27);
+        HELPER_TEST_EQUALS(scheduler.bracket_size(2),12);
+        HELPER_TEST_EQUALS(scheduler.bracket_size(1),6);
+        HELPER_TEST_EQUALS(scheduler.bracket_size(0),4);
+        HELPER_TEST_EQUALS(scheduler.rung_budget(3,0),1);
+        HELPER_TEST_EQUALS(scheduler.rung_budget(3,2),9);
+        HELPER_TEST_EQUALS(scheduler.rung_budget(1,0),9);
+        HELPER_TEST_EQUALS(scheduler.rung_budget(0,0),27);
+        HELPER_TEST_EQUALS(scheduler.num_promoted(27),9);
+        HELPER_TEST_EQUALS(scheduler.num_promoted(2),1);
+        HELPER_TEST_EQUALS(ConfigurationSearchScheduler(0.1, 0.25, 2).num_brackets(),2);
+        HELPER_TEST_FAIL(ConfigurationSearchScheduler(2, 1));
+        HELPER_TEST_FAIL(ConfigurationSearchScheduler(1, 2, 1));
+        HELPER_TEST_FAIL(scheduler.rung_budget(1,2));
+    }
+
+    void test_successive_halving() {
+        Configuration<TestSearchable> cfg;
+        auto space = cfg.search_space();
+        List<ConfigurationSearchPoint> points;
+        for (size_t i=0; i<space.total_points(); ++i) points.push_back(space.point_at(i));
+        std::mutex mutex;
+        Map<double,size_t> evaluations_per_budget;
+        auto cost = [&](Configuration<TestSearchable> const& c, double budget) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++evaluations_per_budget[budget];
+            return (c.order()-5)*(c.order()-5) + c.depth() + 1.0/budget;
+        };
+        ConfigurationSearchEvaluator evaluator(3);
+        ConfigurationSearchScheduler scheduler(1, 27);
+        auto stages = scheduler.successive_halving(evaluator, cfg, points, cost);
+        HELPER_TEST_EQUALS(stages.size(),4);
+        HELPER_TEST_EQUALS(evaluations_per_budget.size(),4);
+        HELPER_TEST_EQUALS(evaluations_per_budget[1],27);
+        HELPER_TEST_EQUALS(evaluations_per_budget[3],9);
+        HELPER_TEST_EQUALS(evaluations_per_budget[9],3);
+        HELPER_TEST_EQUALS(evaluations_per_budget[27],1);
+        for (size_t i=1; i<stages.size(); ++i) {
+            HELPER_TEST_EQUALS(stages[i].rung,i);
+            HELPER_TEST_EQUALS(stages[i].incumbent().point,stages[i-1].incumbent().point);
+        }
+        auto best = best_at_maximum_budget(stages);
+        HELPER_TEST_EQUALS(best.point.value(space.index(ConfigurationPropertyPath("order"))),5);
+        HELPER_TEST_EQUALS(best.cost,1.0+1.0/27);
+
+        CancellationToken cancellation;
+        auto cancelling_cost = [&](Configuration<TestSearchable> const& c, double budget) { cancellation.cancel(); return cost(c, budget); };
+        auto cancelled = scheduler.successive_halving(evaluator, cfg, points, cancelling_cost, cancellation);
+        HELPER_TEST_EQUALS(cancelled.size(),1);
+        HELPER_TEST_FAIL(best_at_maximum_budget(cancelled));
+    }
+
+    void test_hyperband() {
+        Configuration<TestSearchable> cfg;
+        std::atomic<size_t> num_evaluations(0);
+        auto cost = [&](Configuration<TestSearchable> const& c, double budget) { ++num_evaluations; return c.order() + c.depth()/budget; };
+        ConfigurationSearchEvaluator evaluator(2);
+        ConfigurationSearchScheduler scheduler(1, 9);
+        RandomEngine engine(5);
+        auto stages = scheduler.hyperband(evaluator, cfg, cost, ConfigurationSearchSampling::LATIN_HYPERCUBE, engine);
+        HELPER_TEST_EQUALS(stages.size(),3+2+1);
+        HELPER_TEST_EQUALS(num_evaluations.load(),(9+3+1)+(5+1)+3);
+        size_t num_final = 0;
+        for (auto const& stage : stages) if (stage.rung == stage.bracket) ++num_final;
+        HELPER_TEST_EQUALS(num_final,3);
+        HELPER_TEST_PRINT(best_at_maximum_budget(stages).point);
+    }
+
+    void test_cached_evaluator() {
+        Configuration<TestSearchable> cfg;
+        auto space = cfg.search_space();
+        List<ConfigurationSearchPoint> points;
+        for (size_t i=0; i<space.total_points(); ++i) points.push_back(space.point_at(i));
+        auto cost = [](Configuration<TestSearchable> const& c, double budget) { return c.order() + 100.0/budget; };
+        ConfigurationSearchEvaluator evaluator(2, std::make_shared<ConfigurationSearchEvaluationCache>(100));
+        ConfigurationSearchScheduler scheduler(1, 9);
+        RandomEngine engine(6);
+        HELPER_TEST_FAIL(scheduler.successive_halving(evaluator, cfg, points, cost));
+        HELPER_TEST_FAIL(scheduler.hyperband(evaluator, cfg, cost, ConfigurationSearchSampling::LATIN_HYPERCUBE, engine));
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_budgets());
+        HELPER_TEST_CALL(test_successive_halving());
+        HELPER_TEST_CALL(test_hyperband());
+        HELPER_TEST_CALL(test_cached_evaluator());
+    }
+};
+
+int main() {
+    TestConfigurationSearchScheduler().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,150 @@
+/***************************************************************************
+ *            test/test_configuration_search_surrogate.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "configuration_search_surrogate.hpp"
+#include "configuration_search_point_set.hpp"
+#include "configuration_search_fixture.hpp"
+
+using namespace ProNest;
+
+class TestConfigurationSearchSurrogate {
+  public:
+
+    void test_expected_improvement() {
+        HELPER_TEST_EQUALS(expected_improvement({1.0, 0.0}, 3.0),2.0);
+        HELPER_TEST_EQUALS(expected_improvement({4.0, 0.0}, 3.0),0.0);
+        HELPER_TEST_ASSERT(expected_improvement({4.0, 1.0}, 3.0) > 0.0);
+        HELPER_TEST_ASSERT(expected_improvement({3.0, 4.0}, 3.0) > expected_improvement({3.0, 1.0}, 3.0));
+        HELPER_TEST_ASSERT(expected_improvement({2.0, 1.0}, 3.0) > expected_improvement({3.0, 1.0}, 3.0));
+    }
+
+    void test_forest_metric() {
+        auto space = make_bowl_space();
+        ConfigurationSearchForest forest(8);
+        HELPER_TEST_FAIL(forest.fit(RandomEngine::thread_engine()));
+        for (int x=0; x<=20; x+=2)
+            for (int y=0; y<=20; y+=2) {
+                auto point = space.make_point(List<int>({x, y}));
+                forest.add(point, bowl(point));
+            }
+        HELPER_TEST_EQUALS(forest.num_observations(),121);
+        HELPER_TEST_ASSERT(not forest.is_fitted());
+        RandomEngine engine(1);
+        forest.fit(engine, 2);
+        HELPER_TEST_ASSERT(forest.is_fitted());
+        auto near = forest.predict(space.make_point(List<int>({13, 5})));
+        auto far = forest.predict(space.make_point(List<int>({0, 20})));
+        HELPER_TEST_ASSERT(near.mean < 30.0);
+        HELPER_TEST_ASSERT(far.mean > 300.0);
+        HELPER_TEST_ASSERT(near.variance >= 0.0);
+    }
+
+    void test_forest_categorical() {
+        ConfigurationSearchParameter kind(ConfigurationPropertyPath("kind"), false, List<int>({0, 1, 2, 3}));
+        ConfigurationSearchParameter size(ConfigurationPropertyPath("size"), true, List<int>({0, 1, 2, 3}));
+        ConfigurationSearchSpace space({kind, size});
+        ConfigurationSearchForest forest(8, 2);
+        for (int k=0; k<4; ++k)
+            for (int s=0; s<4; ++s) {
+                auto point = space.make_point(List<int>({k, s}));
+                forest.add(point, (k == 2 ? 0.0 : 10.0) + s);
+            }
+        RandomEngine engine(2);
+        forest.fit(engine);
+        auto selected = forest.predict(space.make_point(List<int>({2, 0})));
+        auto other = forest.predict(space.make_point(List<int>({1, 0})));
+        HELPER_TEST_ASSERT(selected.mean < other.mean);
+    }
+
+    void test_optimise() {
+        auto space = make_bowl_space();
+        RandomEngine engine(3);
+        ConfigurationSearchSurrogateOptimiser optimiser(10, 6, 12);
+        optimiser.set_concurrency(3);
+        HELPER_TEST_FAIL(optimiser.set_random_fraction(1.5));
+        auto result = optimiser.optimise(space, bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,0.0);
+        HELPER_TEST_EQUALS(result.best,space.make_point(List<int>({13, 4})));
+        HELPER_TEST_ASSERT(result.evaluations.size() <= 10+6*12);
+        ConfigurationSearchPointSet points;
+        for (auto const& e : result.evaluations) {
+            HELPER_TEST_EQUALS(e.cost,bowl(e.point));
+            points.insert(e.point);
+        }
+        HELPER_TEST_EQUALS(points.size(),result.evaluations.size());
+
+        optimiser.set_cache(std::make_shared<ConfigurationSearchEvaluationCache>(1000));
+        RandomEngine first_engine(6), second_engine(6);
+        auto first = optimiser.optimise(space, bowl, first_engine);
+        auto second = optimiser.optimise(space, bowl, second_engine);
+        HELPER_TEST_EQUALS(second.evaluations.size(),first.evaluations.size());
+        for (auto const& e : first.evaluations) HELPER_TEST_ASSERT(not e.is_cached);
+        for (auto const& e : second.evaluations) HELPER_TEST_ASSERT(e.is_cached);
+    }
+
+    void test_optimise_exhausted() {
+        ConfigurationSearchParameter xp(ConfigurationPropertyPath("x"), true, List<int>({0, 1, 2}));
+        ConfigurationSearchParameter yp(ConfigurationPropertyPath("y"), true, List<int>({0, 1}));
+        ConfigurationSearchSpace space({xp, yp});
+        RandomEngine engine(4);
+        ConfigurationSearchSurrogateOptimiser optimiser(4, 4, 10);
+        auto result = optimiser.optimise(space, [](ConfigurationSearchPoint const& p) { return static_cast<double>(p.value(0)+p.value(1)); }, engine);
+        HELPER_TEST_EQUALS(result.evaluations.size(),6);
+        HELPER_TEST_EQUALS(result.best_cost,0.0);
+
+        CancellationToken cancellation;
+        result = optimiser.optimise(space, [&](ConfigurationSearchPoint const& p) { cancellation.cancel(); return static_cast<double>(p.value(0)); }, engine, cancellation);
+        HELPER_TEST_EQUALS(result.evaluations.size(),4);
+        result = optimiser.optimise(space, [](ConfigurationSearchPoint const& p) { return static_cast<double>(p.value(0)+p.value(1)); }, engine, cancellation);
+        HELPER_TEST_EQUALS(result.evaluations.size(),4);
+        HELPER_TEST_EQUALS(result.best_cost,result.evaluations.front().cost);
+    }
+
+    void test_optimise_configuration() {
+        Configuration<TestSearchable> cfg;
+        RandomEngine engine(5);
+        ConfigurationSearchSurrogateOptimiser optimiser(6, 3, 6);
+        auto result = optimiser.optimise(cfg, configuration_bowl, engine);
+        HELPER_TEST_EQUALS(result.best_cost,1.0);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_expected_improvement());
+        HELPER_TEST_CALL(test_forest_metric());
+        HELPER_TEST_CALL(test_forest_categorical());
+        HELPER_TEST_CALL(test_optimise());
+        HELPER_TEST_CALL(test_optimise_exhausted());
+        HELPER_TEST_CALL(test_optimise_configuration());
+    }
+};
+
+int main() {
+    TestConfigurationSearchSurrogate().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,107 @@
+/***************************************************************************
+ *            test_random_engine.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of ProNest, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helper/test.hpp"
+#include "random_engine.hpp"
+#include "configuration_search_point.hpp"
+
+using namespace ProNest;
+
+class TestRandomEngine {
+  public:
+
+    List<uint64_t> draw(RandomEngine& engine, size_t amount) {
+        List<uint64_t> result;
+        for (size_t i=0; i<amount; ++i) result.push_back(engine());
+        return result;
+    }
+
+    void test_seeding() {
+        RandomEngine a(42), b(42), c(43);
+        auto a_values = draw(a,16);
+        HELPER_TEST_ASSERT(a_values == draw(b,16));
+        HELPER_TEST_ASSERT(a_values != draw(c,16));
+    }
+
+    void test_streams() {
+        RandomEngine s0(42,0), s1(42,1), s0_again(42,0);
+        auto s0_values = draw(s0,16);
+        HELPER_TEST_ASSERT(s0_values != draw(s1,16));
+        HELPER_TEST_ASSERT(s0_values == draw(s0_again,16));
+
+        RandomEngine parent1(7), parent2(7);
+        auto child1 = parent1.split();
+        auto child2 = parent2.split();
+        auto child1_values = draw(child1,16);
+        HELPER_TEST_ASSERT(child1_values == draw(child2,16));
+        HELPER_TEST_ASSERT(child1_values != draw(parent1,16));
+    }
+
+    void test_uniform() {
+        RandomEngine engine(1);
+        List<size_t> counts(5,0);
+        for (size_t i=0; i<5000; ++i) {
+            int value = engine.uniform<int>(-2,2);
+            HELPER_TEST_ASSERT(value >= -2 and value <= 2);
+            ++counts[static_cast<size_t>(value+2)];
+        }
+        for (auto const& c : counts) HELPER_TEST_ASSERT(c > 800 and c < 1200);
+        HELPER_TEST_EQUALS(engine.uniform<size_t>(3,3),3);
+        HELPER_TEST_FAIL(engine.uniform<int>(1,0));
+    }
+
+    void test_reproducible_points() {
+        ConfigurationSearchParameter bp(ConfigurationPropertyPath("use_subdivisions"), false, List<int>({0, 1}));
+        ConfigurationSearchParameter mp(ConfigurationPropertyPath("sweep_threshold"), true, List<int>({3, 4, 5, 6, 7, 8}));
+        ConfigurationSearchParameter ep(ConfigurationPropertyPath("level"), false, List<int>({2, 7, 4}));
+        ConfigurationSearchSpace space({bp, mp, ep});
+        RandomEngine a(5), b(5);
+        auto point_a = space.initial_point(a);
+        auto point_b = space.initial_point(b);
+        HELPER_TEST_EQUALS(point_a,point_b);
+        HELPER_TEST_ASSERT(point_a.make_random_shifted(10,a) == point_b.make_random_shifted(10,b));
+        HELPER_TEST_ASSERT(make_extended_set_by_shifting({point_a},20,a) == make_extended_set_by_shifting({point_b},20,b));
+
+        RandomEngine::thread_engine() = RandomEngine(5);
+        auto first_point = space.initial_point();
+        RandomEngine::thread_engine() = RandomEngine(5);
+        HELPER_TEST_EQUALS(space.initial_point(),first_point);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_seeding());
+        HELPER_TEST_CALL(test_streams());
+        HELPER_TEST_CALL(test_uniform());
+        HELPER_TEST_CALL(test_reproducible_points());
+    }
+};
+
+int main() {
+    TestRandomEngine().test();
+    return HELPER_TEST_FAILURES;
+}
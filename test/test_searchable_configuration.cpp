@@ -33,6 +33,7 @@
 #include "configuration_search_space.hpp"
 #include "configurable.tpl.hpp"
 #include "configuration_search_point.hpp"
+#include "configuration_property_handle.hpp"
 
 using namespace std;
 using namespace Helper;
@@ -214,6 +215,27 @@ class Top : public Configurable<Top>, public WritableInterface {
     ostream& _write(ostream& os) const override { os << "configuration:" << configuration(); return os; }
 };
 
+class TestConfigurableHandle : public Handle<TestConfigurableInterface>, public WritableInterface {
+  public:
+    using Handle<TestConfigurableInterface>::Handle;
+    ostream& _write(ostream& os) const override { return _ptr->_write(os); }
+};
+
+using TestConfigurableHandleConfigurationProperty = HandleListConfigurationProperty<TestConfigurableHandle>;
+
+class HandleTop;
+
+namespace ProNest {
+
+template<> struct Configuration<HandleTop> : public SearchableConfiguration {
+  public:
+    Configuration(TestConfigurableHandle const& handle) {
+        add_property("configurable_handle",TestConfigurableHandleConfigurationProperty(handle));
+    }
+};
+
+}
+
 class TestSearchableConfiguration {
   public:
 
@@ -246,6 +268,59 @@ class TestSearchableConfiguration {
         HELPER_TEST_EQUALS(sublevel_prop_again.get(),LevelOptions::LOW);
     }
 
+    void test_configuration_copy_on_write() {
+        Configuration<Top> a;
+        Configuration<Top> b = a;
+        ConfigurationPropertyPath level("level");
+        ConfigurationPropertyPath sublevel = ConfigurationPropertyPath("test_configurable").append("_level");
+        SearchableConfiguration const& ca = a;
+        SearchableConfiguration const& cb = b;
+        HELPER_TEST_ASSERT(&ca.property_at(level) == &cb.property_at(level));
+        HELPER_TEST_ASSERT(&ca.property_at(sublevel) == &cb.property_at(sublevel));
+        b.set_level(LevelOptions::HIGH);
+        HELPER_TEST_EQUALS(a.level(),LevelOptions::LOW);
+        HELPER_TEST_EQUALS(b.level(),LevelOptions::HIGH);
+        HELPER_TEST_ASSERT(&ca.property_at(level) != &cb.property_at(level));
+        HELPER_TEST_ASSERT(&ca.property_at(sublevel) == &cb.property_at(sublevel));
+        b.at<LevelOptionsConfigurationProperty>(sublevel).set({LevelOptions::MEDIUM, LevelOptions::HIGH});
+        HELPER_TEST_EQUALS(a.at<LevelOptionsConfigurationProperty>(sublevel).get(),LevelOptions::LOW);
+        HELPER_TEST_EQUALS(b.at<LevelOptionsConfigurationProperty>(sublevel).cardinality(),2);
+        HELPER_TEST_ASSERT(a.is_singleton());
+        HELPER_TEST_ASSERT(not b.is_singleton());
+        auto c = make_singleton(b,b.search_space().initial_point());
+        HELPER_TEST_ASSERT(c.is_singleton());
+        HELPER_TEST_ASSERT(not b.is_singleton());
+        HELPER_TEST_ASSERT(&cb.property_at(level) == &static_cast<SearchableConfiguration const&>(c).property_at(level));
+        auto const properties = ca.properties();
+        static_assert(std::is_const_v<std::remove_reference_t<decltype(*properties.begin()->second)>>);
+        HELPER_TEST_ASSERT(properties.find("level")->second.get() == &ca.property_at(level));
+        HELPER_TEST_ASSERT(properties.find("level")->second.get() != &cb.property_at(level));
+    }
+
+    void test_configuration_handle() {
+        Configuration<Top> a;
+        ConfigurationPropertyPath sublevel = ConfigurationPropertyPath("test_configurable").append("_level");
+        ConfigurationPropertyHandle<LevelOptionsConfigurationProperty> level_handle(a,ConfigurationPropertyPath("level"));
+        ConfigurationPropertyHandle<LevelOptionsConfigurationProperty> sublevel_handle(a,sublevel);
+        HELPER_TEST_EQUALS(sublevel_handle.path(),sublevel);
+        HELPER_TEST_FAIL(ConfigurationPropertyHandle<BooleanConfigurationProperty>(a,sublevel));
+        Configuration<Top> b = a;
+        b.set_level(LevelOptions::HIGH);
+        HELPER_TEST_EQUALS(a.at(level_handle).get(),LevelOptions::LOW);
+        HELPER_TEST_EQUALS(b.at(level_handle).get(),LevelOptions::HIGH);
+        b.at(sublevel_handle).set({LevelOptions::MEDIUM, LevelOptions::HIGH});
+        HELPER_TEST_EQUALS(a.at(sublevel_handle).get(),LevelOptions::LOW);
+        HELPER_TEST_EQUALS(b.at(sublevel_handle).cardinality(),2);
+        HELPER_TEST_ASSERT(&b.at(sublevel_handle) == &b.at<LevelOptionsConfigurationProperty>(sublevel));
+        Configuration<Top> c;
+        HELPER_TEST_FAIL(c.at(level_handle));
+        HELPER_TEST_FAIL(b.replace_property("incorrect",LevelOptionsConfigurationProperty(LevelOptions::HIGH)));
+        b.replace_property("level",LevelOptionsConfigurationProperty(LevelOptions::MEDIUM));
+        HELPER_TEST_EQUALS(b.level(),LevelOptions::MEDIUM);
+        HELPER_TEST_FAIL(b.at(level_handle));
+        HELPER_TEST_EQUALS(a.at(level_handle).get(),LevelOptions::LOW);
+    }
+
     void test_configuration_search_space() {
         Configuration<Top> a;
         HELPER_TEST_EQUALS(a.search_space().dimension(),0);
@@ -256,6 +331,31 @@ class TestSearchableConfiguration {
         HELPER_TEST_EQUALS(search_space.total_points(),2);
     }
 
+    void test_configuration_caching() {
+        Configuration<Top> a;
+        ConfigurationPropertyPath sublevel = ConfigurationPropertyPath("test_configurable").append("_level");
+        auto version = a.version();
+        HELPER_TEST_EQUALS(a.version(),version);
+        HELPER_TEST_EQUALS(a.search_space().dimension(),0);
+        a.set_both_use_reconditioning();
+        HELPER_TEST_ASSERT(a.version() > version);
+        version = a.version();
+        HELPER_TEST_EQUALS(a.search_space().dimension(),1);
+        auto& property = a.at<LevelOptionsConfigurationProperty>(sublevel);
+        HELPER_TEST_EQUALS(a.search_space().dimension(),1);
+        HELPER_TEST_EQUALS(a.version(),version);
+        property.set({LevelOptions::MEDIUM, LevelOptions::HIGH});
+        HELPER_TEST_ASSERT(a.version() > version);
+        HELPER_TEST_EQUALS(a.search_space().dimension(),2);
+        HELPER_TEST_EQUALS(a.integer_values().at(sublevel).size(),2);
+        HELPER_TEST_ASSERT(not a.is_singleton());
+        Configuration<Top> b = a;
+        HELPER_TEST_EQUALS(b.version(),a.version());
+        b.set_use_reconditioning(true);
+        HELPER_TEST_EQUALS(a.search_space().dimension(),2);
+        HELPER_TEST_EQUALS(b.search_space().dimension(),1);
+    }
+
     void test_configuration_make_singleton() {
         Configuration<Top> a;
         a.set_both_use_reconditioning();
@@ -301,6 +401,95 @@ class TestSearchableConfiguration {
         HELPER_TEST_FAIL(make_singleton(a,search_space7.initial_point()));
     }
 
+    void test_configuration_make_singletons() {
+        Configuration<Top> a;
+        a.set_both_use_reconditioning();
+        a.set_maximum_order(2,6);
+        auto search_space = a.search_space();
+        auto points = search_space.initial_point().make_random_shifted(search_space.total_points());
+        HELPER_TEST_EQUALS(points.size(),10);
+        for (size_t concurrency : {1u, 4u}) {
+            auto singletons = make_singletons(a,points,concurrency);
+            HELPER_TEST_EQUALS(singletons.size(),points.size());
+            auto iter = points.begin();
+            for (auto const& s : singletons) {
+                HELPER_TEST_ASSERT(s.is_singleton());
+                HELPER_TEST_EQUALS(s.use_reconditioning(),iter->value(ConfigurationPropertyPath("use_reconditioning")) == 1);
+                HELPER_TEST_EQUALS(s.maximum_order(),iter->value(ConfigurationPropertyPath("maximum_order")));
+                ++iter;
+            }
+        }
+        HELPER_TEST_ASSERT(not a.is_singleton());
+        HELPER_TEST_EQUALS(make_singletons(a,List<ConfigurationSearchPoint>()).size(),0);
+
+        ConfigurationSearchParameter p1(ConfigurationPropertyPath("use_reconditioning"), false, List<int>({0, 1}));
+        ConfigurationSearchSpace partial_space({p1});
+        HELPER_TEST_FAIL(make_singletons(a,List<ConfigurationSearchPoint>({partial_space.initial_point()}),2));
+        ConfigurationSearchParameter p2(ConfigurationPropertyPath("maximum_order"), true, List<int>({2, 3, 4, 5, 6}));
+        HELPER_TEST_FAIL(make_singletons(a,List<ConfigurationSearchPoint>({partial_space.initial_point(),ConfigurationSearchSpace({p1,p2}).initial_point()})));
+    }
+
+    void test_configuration_handle_make_singletons() {
+        Configuration<TestConfigurable> ctc;
+        ctc.set_both_use_reconditioning();
+        ctc.at<IntegerConfigurationProperty>("_maximum_order").set(1,8);
+        auto shared = std::make_shared<TestConfigurable>(ctc);
+        Configuration<HandleTop> a{TestConfigurableHandle(std::shared_ptr<TestConfigurableInterface>(shared))};
+        auto search_space = a.search_space();
+        HELPER_TEST_EQUALS(search_space.total_points(),16);
+        List<ConfigurationSearchPoint> points;
+        for (size_t i=0; i<search_space.total_points(); ++i) points.push_back(search_space.point_at(i));
+        auto const reconditioning = ConfigurationPropertyPath("configurable_handle").append("_use_reconditioning");
+        auto const order = ConfigurationPropertyPath("configurable_handle").append("_maximum_order");
+        auto singletons = make_singletons(a,points,4);
+        for (size_t i=0; i<points.size(); ++i) {
+            auto const& s = singletons[i];
+            HELPER_TEST_ASSERT(s.is_singleton());
+            HELPER_TEST_EQUALS(s.at<BooleanConfigurationProperty>(reconditioning).get(),points[i].value(reconditioning) == 1);
+            HELPER_TEST_EQUALS(s.at<IntegerConfigurationProperty>(order).get(),points[i].value(order));
+            for (size_t j=0; j<i; ++j)
+                HELPER_TEST_ASSERT(&s.at<IntegerConfigurationProperty>(order) != &singletons[j].at<IntegerConfigurationProperty>(order));
+        }
+        HELPER_TEST_ASSERT(not a.is_singleton());
+        HELPER_TEST_EQUALS(shared->configuration().search_space().total_points(),16);
+    }
+
+    void test_configuration_constraints() {
+        Configuration<Top> a;
+        ConfigurationPropertyPath order("maximum_order");
+        ConfigurationPropertyPath sub_order = ConfigurationPropertyPath("test_configurable").append("_maximum_order");
+        HELPER_TEST_FAIL(a.add_constraint(ConfigurationSearchConstraint::less_or_equal(order, ConfigurationPropertyPath("incorrect"))));
+        a.add_constraint(ConfigurationSearchConstraint::less_or_equal(order, sub_order));
+        HELPER_TEST_EQUALS(a.constraints().size(),1);
+        a.set_maximum_order(2,8);
+        auto space = a.search_space();
+        HELPER_TEST_PRINT(space);
+        HELPER_TEST_EQUALS(space.constraints().size(),1);
+        HELPER_TEST_EQUALS(space.constraints()[0].paths().size(),1);
+        for (uint64_t i=0; i<space.total_points(); ++i) {
+            auto point = space.point_at(i);
+            HELPER_TEST_EQUALS(space.is_feasible(point),point.value(order) <= 5);
+        }
+        Configuration<Top> b = a;
+        HELPER_TEST_ASSERT(b.search_space() == space);
+        auto points = space.initial_point().make_random_shifted(4);
+        for (auto const& s : make_singletons(a,points,2)) HELPER_TEST_ASSERT(s.maximum_order() <= 5);
+
+        b.at<IntegerConfigurationProperty>(sub_order).set(3,6);
+        auto free_space = b.search_space();
+        HELPER_TEST_EQUALS(free_space.dimension(),2);
+        HELPER_TEST_EQUALS(free_space.constraints()[0].paths().size(),2);
+        HELPER_TEST_ASSERT(not (free_space == space));
+        for (auto const& s : make_singletons(b,free_space.initial_point().make_random_shifted(8),2))
+            HELPER_TEST_ASSERT(s.maximum_order() <= s.at<IntegerConfigurationProperty>(sub_order).get());
+
+        a.set_maximum_order(4);
+        HELPER_TEST_EQUALS(a.search_space().dimension(),0);
+        a.set_maximum_order(7);
+        HELPER_TEST_ASSERT(a.is_singleton());
+        HELPER_TEST_FAIL(a.search_space());
+    }
+
     void test_configuration_hierarchic_search_space() {
         Configuration<Top> ca;
         Configuration<TestConfigurable> ctc;
@@ -338,8 +527,14 @@ class TestSearchableConfiguration {
     void test() {
         HELPER_TEST_CALL(test_configuration_construction());
         HELPER_TEST_CALL(test_configuration_at());
+        HELPER_TEST_CALL(test_configuration_copy_on_write());
+        HELPER_TEST_CALL(test_configuration_handle());
         HELPER_TEST_CALL(test_configuration_search_space());
+        HELPER_TEST_CALL(test_configuration_caching());
         HELPER_TEST_CALL(test_configuration_make_singleton());
+        HELPER_TEST_CALL(test_configuration_make_singletons());
+        HELPER_TEST_CALL(test_configuration_handle_make_singletons());
+        HELPER_TEST_CALL(test_configuration_constraints());
         HELPER_TEST_CALL(test_configuration_hierarchic_search_space());
         HELPER_TEST_CALL(test_configuration_hierarchic_make_singleton());
     }